@@ -0,0 +1,176 @@
+// 多线程词法分析压力测试
+//
+// 用 1, 2, 4, ... N 个线程同时分析一组文件：每个线程从共享的计数器领取文件，为每个
+// 文件构造新的词法分析器并完整分析（错误的文件在恢复模式下分析），同时共享一个符号表，
+// 以此检验词法分析器的全局状态可以安全地并发使用。输出各线程数下的吞吐量和相对单线程
+// 的加速比；任一线程数下的Token总数与单线程不一致时以失败退出。
+//
+// 用法：lexer_stress [-j 最大线程数] [-r 重复轮数] [-e classic|table] [文件...]
+// 不指定文件时使用内置生成的源码。
+
+#include "lexer/lexical.h"
+#include "lexer/source_file.h"
+#include "lexer/symbol_table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dreamlang::lexer;
+
+namespace {
+
+struct Options {
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned repeat = 3;
+    LexerEngine engine = LexerEngine::CLASSIC;
+    std::vector<std::string> files;
+};
+
+// 生成内置的测试源码：若干大小不同的文件，覆盖各类Token、注释、转义和一处词法错误
+std::vector<std::string> generateSources() {
+    const char* lines[] = {
+        "var count = 0x1F + 0b1010 * 3.5e2 // 计数\n",
+        "fun greet(name: string) { return \"hello, \\\"\" + name + \"\\n\" }\n",
+        "/* 多行\n   注释 */ if (a >= b && c != d || !e) { 变量 = 'x' }\n",
+        "for (i in array) { total = total ** 2 % 7; values[i] = '\\t' }\n",
+        "class Point { val x: number = 1_000; val y: number = 2.5 }\n",
+    };
+    std::vector<std::string> sources;
+    for (size_t i = 0; i < 64; ++i) {
+        std::string source;
+        size_t line_count = 200 + (i * 997) % 4000;
+        for (size_t line = 0; line < line_count; ++line) {
+            source += lines[(i + line) % std::size(lines)];
+        }
+        if (i % 16 == 15) {
+            source += "var broken = \"unterminated\n";
+        }
+        sources.push_back(std::move(source));
+    }
+    return sources;
+}
+
+// 分析一个文件，返回Token数（含恢复模式下的ERROR Token）
+size_t lexOne(std::string_view source, LexerEngine engine, SymbolTable& symbols) {
+    Lexical lexer(source, engine);
+    lexer.setErrorRecovery(true);
+    lexer.setSymbolTable(&symbols);
+    return lexer.tokenize().size();
+}
+
+// 用 threads 个线程把所有源码分析 repeat 遍，返回Token总数和耗时（秒）
+std::pair<size_t, double> run(const std::vector<std::string_view>& sources, unsigned threads, unsigned repeat,
+                              LexerEngine engine) {
+    SymbolTable symbols;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> total{0};
+    const size_t jobs = sources.size() * repeat;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&]() {
+            size_t local = 0;
+            for (size_t job = next++; job < jobs; job = next++) {
+                local += lexOne(sources[job % sources.size()], engine, symbols);
+            }
+            total += local;
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return {total.load(), elapsed.count()};
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "-j" || arg == "-r" || arg == "-e") && i + 1 < argc) {
+            std::string value = argv[++i];
+            if (arg == "-e") {
+                if (!parseLexerEngine(value, options.engine)) {
+                    return false;
+                }
+                continue;
+            }
+            long number = std::strtol(value.c_str(), nullptr, 10);
+            if (number <= 0) {
+                return false;
+            }
+            (arg == "-j" ? options.max_threads : options.repeat) = static_cast<unsigned>(number);
+        } else if (!arg.empty() && arg[0] == '-') {
+            return false;
+        } else {
+            options.files.push_back(arg);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [-j max_threads] [-r repeat] [-e classic|table] [files...]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<SourceFile> files;
+    std::vector<std::string> generated;
+    std::vector<std::string_view> sources;
+    try {
+        files.reserve(options.files.size());
+        for (const std::string& path : options.files) {
+            files.push_back(SourceFile::open(path));
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+    // 全部加载之后再取视图：未映射的文件内容随 SourceFile 移动，files 扩容会使之前的视图失效
+    for (const SourceFile& file : files) {
+        sources.push_back(file.view());
+    }
+    if (sources.empty()) {
+        generated = generateSources();
+        sources.assign(generated.begin(), generated.end());
+    }
+
+    size_t bytes = 0;
+    for (std::string_view source : sources) {
+        bytes += source.size();
+    }
+    bytes *= options.repeat;
+
+    std::printf("%zu files, %.1f MiB per run\n", sources.size(), bytes / (1024.0 * 1024.0));
+    std::printf("%8s %12s %12s %10s\n", "threads", "seconds", "MiB/s", "speedup");
+
+    size_t expected = 0;
+    double baseline = 0;
+    bool consistent = true;
+    for (unsigned threads = 1;; threads = std::min(threads * 2, options.max_threads)) {
+        auto [tokens, seconds] = run(sources, threads, options.repeat, options.engine);
+        if (threads == 1) {
+            expected = tokens;
+            baseline = seconds;
+        } else if (tokens != expected) {
+            std::printf("token count mismatch with %u threads: %zu != %zu\n", threads, tokens, expected);
+            consistent = false;
+        }
+        std::printf("%8u %12.3f %12.1f %9.2fx\n", threads, seconds, bytes / (1024.0 * 1024.0) / seconds,
+                    baseline / seconds);
+        if (threads >= options.max_threads) {
+            break;
+        }
+    }
+    return consistent ? 0 : 1;
+}
@@ -1,12 +1,18 @@
 #pragma once
 
 #include "message_catalog.h"
+// <locale> 可能间接引入 libintl.h；先于下面的宏引入，避免 ngettext 宏改写其中的声明
+#include <locale>
 #include <memory>
+#include <shared_mutex>
 
 namespace dreamlang::i18n {
 
 /**
  * 本地化管理器，全局管理本地化设置
+ *
+ * 线程安全：多个线程（如并行的词法分析器报告错误时）可以同时查询消息，
+ * 初始化或切换语言环境会等待正在进行的查询结束。
  */
 class LocaleManager {
 public:
@@ -51,7 +57,7 @@ public:
     /**
      * 检查是否已初始化
      */
-    bool isInitialized() const { return catalog_ != nullptr; }
+    bool isInitialized() const;
 
 private:
     LocaleManager() = default;
@@ -61,6 +67,8 @@ private:
     LocaleManager(const LocaleManager&) = delete;
     LocaleManager& operator=(const LocaleManager&) = delete;
 
+    // 保护 catalog_ 及其内容：查询共享加锁，初始化和切换语言环境独占加锁
+    mutable std::shared_mutex mutex_;
     std::unique_ptr<MessageCatalog> catalog_;
 };
 
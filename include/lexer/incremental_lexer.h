@@ -0,0 +1,50 @@
+#pragma once
+
+#include "lexical.h"
+#include "token_buffer.h"
+#include <cstddef>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 一次文本编辑：旧源码中 [offset, offset + old_length) 被替换为 new_length 字节的新文本
+ */
+struct SourceEdit {
+    size_t offset;
+    size_t old_length;
+    size_t new_length;
+};
+
+/**
+ * 增量分析后发生变化的Token区间
+ *
+ * 旧序列的 [first, old_end) 被新序列的 [first, new_end) 取代，其余Token不变
+ * （new_end 之后的Token只是偏移平移了编辑引起的长度差）。
+ */
+struct TokenChange {
+    size_t first;
+    size_t old_end;
+    size_t new_end;
+};
+
+/**
+ * 按一次编辑增量更新Token序列
+ *
+ * 从编辑点之前最近的安全重启位置（不受编辑影响的最后一个Token的结尾）重新分析，
+ * 一旦新产生的Token在编辑之后与旧序列中某个Token的起点对齐就停止——词法分析器
+ * 在Token之间不保留状态，此后的结果必然与旧序列相同。代价只与编辑附近的
+ * Token数量有关，加上对尾部Token偏移的一次平移。
+ *
+ * @param tokens 旧源码的完整Token序列，就地更新为新源码的序列
+ * @param new_source 编辑后的源码，必须比 tokens 存活更久
+ * @param edit 编辑描述
+ * @param engine 使用的词法分析引擎
+ * @param symbols 驻留标识符的符号表（应与产生 tokens 时使用的相同，可为空）
+ * @return 发生变化的Token区间
+ * @throws LexicalException 编辑后的源码有词法错误（此时 tokens 保持不变）
+ */
+TokenChange relexEdit(TokenBuffer& tokens, std::string_view new_source, const SourceEdit& edit,
+                      LexerEngine engine = LexerEngine::CLASSIC, SymbolTable* symbols = nullptr);
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "token_type.h"
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 识别标识符文本对应的Token类型
+ *
+ * 使用编译期生成的完美哈希表，直接作用于源码字节，不做任何内存分配。
+ * @param text 标识符文本
+ * @return 关键字对应的 KW_* 类型、NULL_LITERAL、BOOL_TRUE、BOOL_FALSE，或 IDENT
+ */
+TokenType lookupKeyword(std::string_view text);
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "lexical.h"
+#include "token_buffer.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 预热过的词法分析器池，用于高频分析大量小段输入（如REPL、语言服务）
+ *
+ * 每个池中对象是一个词法分析器和一个与之配套的Token缓冲区。acquire() 取出一个空闲
+ * 对象并通过 Lexical::reset(std::string_view) 指向新的输入，租约结束时对象连同其内部
+ * 容量一起放回池中，因此预热之后重复的小任务不再分配内存。多个线程可以同时从同一个池
+ * 租用和归还。
+ */
+class LexerPool {
+private:
+    struct Entry {
+        Lexical lexer;
+        TokenBuffer tokens;
+
+        explicit Entry(LexerEngine engine) : lexer(std::string_view(), engine) {}
+    };
+
+public:
+    /**
+     * 租约：持有一个词法分析器，析构时归还给池
+     *
+     * 租约只能移动，不能比池存活更久。
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * 租用的词法分析器
+         */
+        Lexical& lexer() { return entry_->lexer; }
+        Lexical* operator->() { return &entry_->lexer; }
+        Lexical& operator*() { return entry_->lexer; }
+
+        /**
+         * 用池中的缓冲区获取剩余的全部Token
+         * @return 复用容量的Token缓冲区，在下次调用或租约结束前有效
+         */
+        const TokenBuffer& tokenize();
+
+    private:
+        friend class LexerPool;
+
+        LexerPool* pool_;
+        std::unique_ptr<Entry> entry_;
+
+        Lease(LexerPool* pool, std::unique_ptr<Entry> entry) : pool_(pool), entry_(std::move(entry)) {}
+    };
+
+    /**
+     * 构造函数
+     * @param engine 池中词法分析器使用的引擎
+     * @param max_idle 最多保留的空闲对象数，0 表示硬件并发数；超出时归还的对象直接释放
+     */
+    explicit LexerPool(LexerEngine engine = LexerEngine::CLASSIC, size_t max_idle = 0);
+
+    LexerPool(const LexerPool&) = delete;
+    LexerPool& operator=(const LexerPool&) = delete;
+
+    /**
+     * 租用一个词法分析器分析 source
+     *
+     * 租到的分析器位于 source 的起点，使用池的引擎，不处于错误恢复模式，也没有符号表；
+     * 在租约内修改的设置会在归还时恢复。
+     * @param source 源代码视图（不拷贝），必须比租约存活更久
+     */
+    Lease acquire(std::string_view source);
+
+    /**
+     * 预先创建空闲对象，直到空闲数达到 count（不超过 max_idle）
+     */
+    void warm(size_t count);
+
+    /**
+     * 当前空闲的对象数
+     */
+    [[nodiscard]] size_t idleCount() const;
+
+private:
+    LexerEngine engine_;
+    size_t max_idle_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Entry>> idle_;
+
+    /**
+     * 归还对象：恢复默认设置后放回空闲列表
+     */
+    void release(std::unique_ptr<Entry> entry);
+};
+
+} // namespace dreamlang::lexer
@@ -1,28 +1,155 @@
 #pragma once
 
 #include "token.h"
+#include "token_buffer.h"
+#include "line_index.h"
 #include "lexical_exception.h"
+#include "lexical_diagnostic.h"
+#include "symbol_table.h"
+#include "trivia_table.h"
+#include "util/arena.h"
+#include <memory_resource>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_set>
 
 namespace dreamlang::lexer {
 
 /**
- * 词法分析器类
+ * 词法分析引擎
  */
-class Lexical {
+enum class LexerEngine : uint8_t {
+    // 逐字符 if/switch 判断的传统实现
+    CLASSIC,
+    // 字符分类表 + 状态转移表驱动的DFA实现
+    TABLE
+};
+
+/**
+ * 根据名称解析词法分析引擎（"classic" / "table"）
+ * @param name 引擎名称
+ * @param engine 解析结果
+ * @return 名称是否有效
+ */
+bool parseLexerEngine(const std::string& name, LexerEngine& engine);
+
+/**
+ * 词法错误的处理方式
+ */
+enum class LexErrorMode : uint8_t {
+    // 由 setErrorRecovery() 在运行时选择
+    CONFIGURABLE,
+    // 总是抛出 LexicalException
+    STRICT,
+    // 总是记录诊断并产生ERROR Token
+    RECOVER
+};
+
+/**
+ * 词法分析器的编译期策略
+ *
+ * 每种组合编译为各自独立的分析循环，关闭的功能在循环中不留下任何判断。
+ * @tparam TrackPositions Token是否记录起始偏移和长度（关闭时均为 0；错误的行列号不受影响）
+ * @tparam EmitTrivia 是否产生 LINEBREAK Token（关闭时换行符与其他空白一样跳过）
+ * @tparam MaterializeValues 是否产生Token值：解码转义、记录标识符编号、解析数值字面量
+ *         （关闭时值为空，字面量只做检查，关键字照常识别；设置了符号表时标识符仍会驻留）
+ * @tparam Errors 词法错误的处理方式
+ * @tparam RetainTrivia 是否把空白和注释的位置记录到琐碎内容表中（见 getTrivia()）
+ */
+template <bool TrackPositions, bool EmitTrivia, bool MaterializeValues, LexErrorMode Errors,
+          bool RetainTrivia = false>
+struct LexPolicy {
+    static constexpr bool kTrackPositions = TrackPositions;
+    static constexpr bool kEmitTrivia = EmitTrivia;
+    static constexpr bool kMaterializeValues = MaterializeValues;
+    static constexpr LexErrorMode kErrors = Errors;
+    static constexpr bool kRetainTrivia = RetainTrivia;
+};
+
+/**
+ * 完整功能的策略（Lexical 使用）
+ */
+using DefaultLexPolicy = LexPolicy<true, true, true, LexErrorMode::CONFIGURABLE>;
+
+/**
+ * 只关心Token类型与数量的策略（CountingLexical 使用）
+ */
+using CountingLexPolicy = LexPolicy<false, false, false, LexErrorMode::STRICT>;
+
+/**
+ * 统计Token数量的策略（StatisticsLexical 使用）：与 CountingLexPolicy 相同，但照常产生换行Token
+ */
+using StatisticsLexPolicy = LexPolicy<false, true, false, LexErrorMode::STRICT>;
+
+/**
+ * 完整功能并保留空白和注释的策略（TriviaLexical 使用）
+ */
+using TriviaLexPolicy = LexPolicy<true, true, true, LexErrorMode::CONFIGURABLE, true>;
+
+/**
+ * 词法分析器类模板
+ *
+ * 分析规则与策略无关，策略只决定产生哪些附带信息（见 LexPolicy）。模板的实现位于
+ * lexical.cpp 与 lexical_table.cpp，只有在那里显式实例化的策略可用：目前是
+ * DefaultLexPolicy（即 Lexical）、CountingLexPolicy（即 CountingLexical）、
+ * StatisticsLexPolicy（即 StatisticsLexical）和 TriviaLexPolicy（即 TriviaLexical）。
+ *
+ * 源码按UTF-8处理：0x80 及以上的字节都是标识符字符，因此中文等非ASCII字符可以直接
+ * 出现在标识符中。分析过程中以向量化的方式按窗口提前验证源码，分析越过非法的UTF-8
+ * 序列时报告错误。
+ *
+ * 产生的Token值直接引用源码缓冲区，只有含转义序列的字符串/字符字面量才会
+ * 解码到实例内部的存储中。因此Token的有效期不超过Lexical实例本身（借用外部
+ * 缓冲区时也不超过该缓冲区），实例也不可拷贝或移动。
+ */
+template <typename Policy>
+class BasicLexical {
 public:
+    /**
+     * 识别一个Token时最多查看其结尾之后的字节数（如 "1." 需要看小数点后是否为数字）
+     *
+     * 流式、增量等分析方式据此判断一个Token是否可能受其后内容的影响。
+     */
+    static constexpr size_t kMaxLookahead = 2;
+
+    /**
+     * 词法规则的版本号
+     *
+     * 同一输入产生的Token序列（类型、边界、值或附加值）发生任何变化时递增，
+     * 磁盘上的Token缓存（见 TokenCache）据此判断是否失效。
+     */
+    static constexpr uint32_t kRulesVersion = 2;
+
     /**
      * 构造函数
      * @param source_code 源代码字符串
+     * @param engine 使用的词法分析引擎，两种引擎产生完全相同的Token流
+     */
+    explicit BasicLexical(std::string source_code, LexerEngine engine = LexerEngine::CLASSIC);
+
+    /**
+     * 构造函数（拷贝C字符串）
+     * @param source_code 以 '\0' 结尾的源代码
+     * @param engine 使用的词法分析引擎
      */
-    explicit Lexical(std::string source_code);
+    explicit BasicLexical(const char* source_code, LexerEngine engine = LexerEngine::CLASSIC);
+
+    /**
+     * 构造函数（借用外部缓冲区，不拷贝）
+     * @param source_view 源代码视图，如内存映射的文件；必须比本实例及其产生的Token存活更久
+     * @param engine 使用的词法分析引擎
+     */
+    explicit BasicLexical(std::string_view source_view, LexerEngine engine = LexerEngine::CLASSIC);
 
     /**
      * 析构函数
      */
-    ~Lexical() = default;
+    ~BasicLexical() = default;
+
+    // Token引用内部缓冲区，禁止拷贝和移动
+    BasicLexical(const BasicLexical&) = delete;
+    BasicLexical& operator=(const BasicLexical&) = delete;
 
     /**
      * 获取下一个Token
@@ -32,9 +159,17 @@ public:
 
     /**
      * 获取所有Token
-     * @return Token列表
+     *
+     * 策略不记录位置时缓冲区中只有Token类型有意义。
+     * @return 紧凑的Token缓冲区，引用本实例的源码
      */
-    std::vector<Token> tokenize();
+    TokenBuffer tokenize();
+
+    /**
+     * 把剩余的全部Token（以EOF结尾）追加到已有的缓冲区，复用其容量
+     * @param tokens 引用本实例源码的Token缓冲区
+     */
+    void tokenize(TokenBuffer& tokens);
 
     /**
      * 重置词法分析器到起始位置
@@ -42,34 +177,192 @@ public:
     void reset();
 
     /**
-     * 获取当前行号
+     * 改为分析新的源码并回到起始位置，保留内部缓冲区的容量
+     *
+     * 引擎、错误恢复模式、符号表和内存资源等设置不变。之前产生的Token及其值全部失效。
+     * 用于反复分析大量小段输入（如REPL）时避免重新构造实例和分配内存。
+     * @param new_source 源代码视图（不拷贝）；必须比本实例之后产生的Token存活更久
+     */
+    void reset(std::string_view new_source);
+
+    /**
+     * 把分析位置移动到 offset（超出末尾时停在末尾）
+     *
+     * 词法分析器在Token之间不保留状态，因此从某个Token的起点或Token之间的空白处
+     * 继续分析，得到的Token与从头顺序分析完全相同。
+     */
+    void seek(size_t offset);
+
+    /**
+     * 设置词法分析引擎
+     */
+    void setEngine(LexerEngine engine) { engine_ = engine; }
+
+    /**
+     * 获取当前使用的词法分析引擎
+     */
+    [[nodiscard]] LexerEngine getEngine() const { return engine_; }
+
+    /**
+     * 启用或关闭错误恢复模式
+     *
+     * 恢复模式下遇到词法错误不抛出异常，而是记录一条诊断、产生一个覆盖出错片段的
+     * ERROR Token，然后从安全位置继续分析；字符串中的非法转义只记录诊断，字面量照常产生。
+     * 只对 LexErrorMode::CONFIGURABLE 策略有效，其他策略的错误处理方式是固定的。
+     */
+    void setErrorRecovery(bool enabled) { error_recovery_ = enabled; }
+
+    /**
+     * 是否处于错误恢复模式
+     */
+    [[nodiscard]] bool getErrorRecovery() const {
+        if constexpr (Policy::kErrors == LexErrorMode::CONFIGURABLE) {
+            return error_recovery_;
+        } else {
+            return Policy::kErrors == LexErrorMode::RECOVER;
+        }
+    }
+
+    /**
+     * 获取恢复模式下收集的诊断（按出现顺序）
+     */
+    [[nodiscard]] const std::vector<LexicalDiagnostic>& getDiagnostics() const { return diagnostics_; }
+
+    /**
+     * 获取分析过程中跳过的空白和注释（仅 RetainTrivia 策略会记录）
+     *
+     * 每项链接到自 reset() 以来产生的第几个Token，从头调用 tokenize() 时即为返回的
+     * 缓冲区中的下标。表只描述顺序分析的结果，seek() 之后的记录不再可靠。
+     */
+    [[nodiscard]] const TriviaTable& getTrivia() const { return trivia_; }
+
+    /**
+     * 设置用于驻留标识符的符号表（可为空，表示不驻留）
+     *
+     * 设置后每个标识符Token都携带其在符号表中的编号（见 Token::getSymbol()；策略不产生值时只驻留），
+     * 符号表可以在多个词法分析器之间共享，必须比本实例存活更久。
+     */
+    void setSymbolTable(SymbolTable* symbols) { symbols_ = symbols; }
+
+    /**
+     * 获取用于驻留标识符的符号表
+     */
+    [[nodiscard]] SymbolTable* getSymbolTable() const { return symbols_; }
+
+    /**
+     * 设置本次分析会话的内存资源
+     *
+     * 解码后的字面量以及 tokenize() 返回的Token缓冲区都从该资源分配，例如交给一个
+     * util::Arena，整个文件的分析只需少数几次系统分配，结束时随竞技场一次释放。
+     * 资源必须比本实例及其产生的Token缓冲区存活更久；设置后之前取得的字面量值失效。
+     */
+    void setMemoryResource(std::pmr::memory_resource* resource);
+
+    /**
+     * 获取本次分析会话的内存资源
+     */
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const { return decoded_.upstream(); }
+
+    /**
+     * 设置源码起点在 SourceManager 中的位置
+     *
+     * 设置后异常和诊断都携带出错处的 SourceLocation；默认为无效位置。
+     * reset(std::string_view) 会清除该设置。
      */
-    [[nodiscard]] int getCurrentLine() const { return line_; }
+    void setFileLocation(SourceLocation file_start) { file_start_ = file_start; }
 
     /**
-     * 获取当前列号
+     * 获取源码起点在 SourceManager 中的位置
      */
-    [[nodiscard]] int getCurrentColumn() const { return column_; }
+    [[nodiscard]] SourceLocation getFileLocation() const { return file_start_; }
+
+    /**
+     * 获取源码中字节偏移 offset 处的 SourceLocation（未设置起点时无效）
+     */
+    [[nodiscard]] SourceLocation getLocation(size_t offset) const {
+        return file_start_.getLocWithOffset(static_cast<uint32_t>(offset));
+    }
+
+    /**
+     * 获取正在分析的源码
+     */
+    [[nodiscard]] std::string_view getSource() const { return source_; }
+
+    /**
+     * 获取当前字节偏移
+     */
+    [[nodiscard]] size_t getOffset() const { return index_; }
+
+    /**
+     * 获取当前行号（通过换行符索引换算）
+     */
+    [[nodiscard]] int getCurrentLine() const;
+
+    /**
+     * 获取当前列号（通过换行符索引换算）
+     */
+    [[nodiscard]] int getCurrentColumn() const;
+
+    /**
+     * 获取源码的换行符索引（首次调用时构建）
+     */
+    const LineIndex& getLineIndex() const;
 
     /**
      * 检查是否到达文件末尾
      */
-    [[nodiscard]] bool isAtEnd() const { return index_ >= source_code_.length(); }
+    [[nodiscard]] bool isAtEnd() const { return index_ >= source_.size(); }
 
 private:
-    std::string source_code_;
+    // 按值构造时持有的源码；借用外部缓冲区时为空
+    std::string owned_source_;
+    // 实际分析的源码视图，指向 owned_source_ 或外部缓冲区
+    std::string_view source_;
+    // 源码起点在 SourceManager 中的位置
+    SourceLocation file_start_;
+    // 含转义的字面量解码后的存储，每个字面量只是竞技场中的一段，不单独分配
+    util::Arena decoded_;
+    // 琐碎内容表，以及链接琐碎内容所用的已产生Token数（仅 RetainTrivia 策略使用）
+    TriviaTable trivia_;
+    size_t tokens_emitted_;
     size_t index_;
-    int line_;
-    int column_;
+    // 当前Token词素的起始偏移
+    size_t token_start_;
+    LexerEngine engine_;
+    // 是否处于错误恢复模式，以及该模式下收集的诊断
+    bool error_recovery_;
+    std::vector<LexicalDiagnostic> diagnostics_;
+    // 驻留标识符的符号表，为空时不驻留
+    SymbolTable* symbols_;
+    // 已验证为合法UTF-8（或已报告过错误）的区间终点，区间从最近一次 seek 的位置开始
+    size_t utf8_checked_;
+    // 换行符索引，仅在需要行列号时构建
+    mutable std::optional<LineIndex> line_index_;
 
-    // 静态查找表
-    static std::unordered_set<std::string> keywords_;
-    static bool initialized_;
+    /**
+     * 传统引擎：逐字符判断获取下一个Token
+     */
+    Token nextTokenClassic();
 
     /**
-     * 初始化静态数据
+     * 表驱动引擎：按字符分类表和状态转移表获取下一个Token（见 lexical_table.cpp）
      */
-    static void initializeStatic();
+    Token nextTokenTable();
+
+    /**
+     * 验证源码直到当前位置（按窗口向前批量验证），报告已越过的非法UTF-8序列
+     */
+    void checkUtf8();
+
+    /**
+     * 前进若干个字符
+     */
+    void advanceBy(size_t count) { index_ += count; }
+
+    /**
+     * 批量前进到 target 位置
+     */
+    void advanceTo(size_t target) { index_ = target; }
 
     /**
      * 获取当前字符
@@ -98,8 +391,16 @@ private:
 
     /**
      * 跳过多行注释
+     * @return 注释是否闭合；未闭合时停在源码末尾
      */
-    void skipMultiLineComment();
+    bool skipMultiLineComment();
+
+    /**
+     * 把 [start, index_) 记录为琐碎内容，链接到下一个产生的Token
+     */
+    void recordTrivia(TriviaKind kind, size_t start) {
+        trivia_.push(kind, start, index_ - start, tokens_emitted_);
+    }
 
     /**
      * 读取标识符或关键字
@@ -107,10 +408,16 @@ private:
     Token readIdentifierOrKeyword();
 
     /**
-     * 读取数字
+     * 读取数字（十进制整数/小数/指数形式，或 0x、0b 前缀的整数，数字之间可以有 '_' 分隔符）
      */
     Token readNumber();
 
+    /**
+     * 跳过一串数字及其中的 '_' 分隔符
+     * @param digit 判断一个字符是否为该进制数字的函数
+     */
+    void skipDigits(bool (*digit)(char));
+
     /**
      * 读取字符串字面量
      */
@@ -137,30 +444,109 @@ private:
     static bool isHexDigit(char c);
 
     /**
-     * 检查字符是否为字母或下划线
+     * 检查字符是否为二进制数字
+     */
+    static bool isBinaryDigit(char c);
+
+    /**
+     * 检查字符是否为字母、下划线或非ASCII字节（UTF-8字符的组成部分）
      */
     static bool isAlpha(char c);
 
     /**
-     * 检查字符是否为字母数字或下划线
+     * 检查字符是否为标识符字符（isAlpha 或数字）
      */
     static bool isAlphaNumeric(char c);
 
     /**
-     * 检查字符串是否为关键字
+     * 创建Token
+     */
+    [[nodiscard]] Token makeToken(TokenType type, std::string_view value = {}) const;
+
+    /**
+     * 当前Token的起始偏移（策略不记录位置时为 0）
      */
-    static bool isKeyword(const std::string& text);
+    [[nodiscard]] uint32_t tokenOffset() const {
+        return Policy::kTrackPositions ? static_cast<uint32_t>(token_start_) : 0;
+    }
 
     /**
-     * 创建Token
+     * 当前Token的长度（策略不记录位置时为 0）
+     */
+    [[nodiscard]] uint32_t tokenLength() const {
+        return Policy::kTrackPositions ? static_cast<uint32_t>(index_ - token_start_) : 0;
+    }
+
+    /**
+     * 用 [token_start_, index_) 的词素创建数字Token，并附上解析好的数值
+     */
+    [[nodiscard]] Token makeNumberToken() const;
+
+    /**
+     * 创建关键字或标识符Token，配置了符号表时驻留标识符
+     */
+    [[nodiscard]] Token makeWordToken(std::string_view text) const;
+
+    /**
+     * 获取源码中 [start, index_) 区间的视图
+     */
+    [[nodiscard]] std::string_view sourceSlice(size_t start) const;
+
+
+    /**
+     * 抛出位于 offset 处的词法错误
+     */
+    [[noreturn]] void throwError(size_t offset, const std::string& error_type, char error_char,
+                                 const std::string& token_type) const;
+
+    /**
+     * 报告当前位置的词法错误：严格模式下抛出异常，恢复模式下只记录诊断并返回
      */
-    [[nodiscard]] Token makeToken(TokenType type, const std::string& value = "") const;
+    void reportError(const std::string& error_type, char error_char, const std::string& token_type) {
+        reportErrorAt(index_, error_type, error_char, token_type);
+    }
 
     /**
-     * 抛出词法错误
+     * 报告位于 offset 处的词法错误（不移动分析位置）
      */
-    void throwError(const std::string& error_type, char error_char, 
-                   const std::string& token_type) const;
+    void reportErrorAt(size_t offset, const std::string& error_type, char error_char, const std::string& token_type);
+
+    /**
+     * 报告词法错误并产生ERROR Token（仅恢复模式下返回）
+     * @param resume 恢复分析的位置，ERROR Token覆盖 [token_start_, resume)
+     */
+    Token errorToken(const std::string& error_type, char error_char, const std::string& token_type,
+                     size_t resume);
+
+    /**
+     * 跳过一个完整的字符（含UTF-8后续字节）后的位置，用于意外字符的恢复
+     */
+    [[nodiscard]] size_t nextCharBoundary(size_t position) const;
 };
 
+/**
+ * 词法分析器（完整功能）
+ */
+using Lexical = BasicLexical<DefaultLexPolicy>;
+
+/**
+ * 只产生Token类型的词法分析器：不记录位置和值，不产生换行Token，遇到错误即抛出异常
+ */
+using CountingLexical = BasicLexical<CountingLexPolicy>;
+
+/**
+ * Token类型序列与 Lexical 完全相同、但不记录位置和值的词法分析器（见 countTokens()）
+ */
+using StatisticsLexical = BasicLexical<StatisticsLexPolicy>;
+
+/**
+ * 记录空白和注释的词法分析器，Token流与 Lexical 完全相同
+ */
+using TriviaLexical = BasicLexical<TriviaLexPolicy>;
+
+extern template class BasicLexical<DefaultLexPolicy>;
+extern template class BasicLexical<CountingLexPolicy>;
+extern template class BasicLexical<StatisticsLexPolicy>;
+extern template class BasicLexical<TriviaLexPolicy>;
+
 } // namespace dreamlang::lexer
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "lexical_exception.h"
+#include "line_index.h"
+#include <cstdint>
+#include <string>
+
+namespace dreamlang::lexer {
+
+/**
+ * 错误恢复模式下记录的一条词法诊断
+ *
+ * 字段与 LexicalException 一一对应，只是位置以字节偏移保存，需要时再换算为行列号。
+ */
+struct LexicalDiagnostic {
+    // 错误类型（已本地化）
+    std::string error_type;
+    // 错误的Token类型
+    std::string token_type;
+    // 出错位置的字节偏移（与严格模式下异常报告的位置相同）
+    uint32_t offset;
+    // 出错Token的起始偏移（通常是对应的 ERROR Token）
+    uint32_t token_offset;
+    // 引起错误的字符
+    char error_char;
+    // 出错位置在 SourceManager 中的位置（源码不属于任何 SourceManager 时无效）
+    SourceLocation location;
+
+    /**
+     * 转换为等价的异常对象（不抛出），以复用其本地化消息格式
+     * @param line_index 源码的换行符索引
+     */
+    [[nodiscard]] LexicalException toException(const LineIndex& line_index) const {
+        SourcePosition position = line_index.resolve(offset);
+        return {error_type, error_char, token_type, position.line, position.column, location};
+    }
+};
+
+} // namespace dreamlang::lexer
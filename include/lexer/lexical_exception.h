@@ -1,5 +1,6 @@
 #pragma once
 
+#include "source_location.h"
 #include <stdexcept>
 #include <string>
 
@@ -17,12 +18,14 @@ public:
      * @param error_token_type 错误的Token类型
      * @param line 错误行号
      * @param column 错误列号
+     * @param location 错误在 SourceManager 中的位置（源码不属于任何 SourceManager 时无效）
      */
     LexicalException(const std::string& error_type,
                     char error_char,
                     const std::string& error_token_type,
                     int line,
-                    int column = -1);
+                    int column = -1,
+                    SourceLocation location = SourceLocation());
 
     /**
      * 构造函数（用于一般错误消息）
@@ -57,6 +60,11 @@ public:
      */
     int getColumn() const { return column_; }
 
+    /**
+     * 获取错误在 SourceManager 中的位置（可能无效）
+     */
+    SourceLocation getLocation() const { return location_; }
+
     /**
      * 获取完整的本地化错误消息
      */
@@ -68,11 +76,16 @@ private:
     std::string error_token_type_;
     int line_;
     int column_;
+    SourceLocation location_;
 
     /**
-     * 生成错误消息
+     * 生成错误消息（在成员初始化之前调用，因此只依赖参数）
      */
-    std::string generateMessage() const;
+    static std::string generateMessage(const std::string& error_type,
+                                       char error_char,
+                                       const std::string& error_token_type,
+                                       int line,
+                                       int column);
 };
 
 } // namespace dreamlang::lexer
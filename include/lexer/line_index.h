@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 源码中的行列位置（均从1开始，列按字节计算）
+ */
+struct SourcePosition {
+    int line;
+    int column;
+};
+
+/**
+ * 换行符偏移索引
+ *
+ * 构建时用向量化扫描一次性记录源码中所有换行符的偏移，之后通过二分查找把
+ * 字节偏移换算为行列号。词法分析的热路径只记录偏移，行列号仅在诊断或工具
+ * 需要时才计算。
+ */
+class LineIndex {
+public:
+    /**
+     * 构造函数
+     * @param source 源码视图（仅在构造期间读取）
+     */
+    explicit LineIndex(std::string_view source);
+
+    /**
+     * 将字节偏移换算为行列号
+     * @param offset 字节偏移，可以等于源码长度
+     */
+    [[nodiscard]] SourcePosition resolve(size_t offset) const;
+
+    /**
+     * 获取偏移所在的行号（从1开始）
+     */
+    [[nodiscard]] int lineOf(size_t offset) const;
+
+    /**
+     * 获取第 line 行（从1开始）起始处的字节偏移
+     * @throws std::out_of_range 行号不在 [1, lineCount()] 范围内
+     */
+    [[nodiscard]] size_t lineStart(int line) const;
+
+    /**
+     * 总行数（最后一个换行符之后的部分也算一行）
+     */
+    [[nodiscard]] size_t lineCount() const { return newlines_.size() + 1; }
+
+    /**
+     * 根据一次编辑就地更新索引，代价与编辑之后的行数成正比而不必重新扫描整个源码
+     * @param new_source 编辑后的源码
+     * @param offset 编辑起点
+     * @param old_length 被替换的旧文本长度
+     * @param new_length 替换进来的新文本长度
+     */
+    void applyEdit(std::string_view new_source, size_t offset, size_t old_length, size_t new_length);
+
+private:
+    std::vector<uint32_t> newlines_;
+};
+
+} // namespace dreamlang::lexer
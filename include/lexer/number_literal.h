@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 数字字面量的类别
+ */
+enum class NumberKind : uint8_t {
+    // 十进制、十六进制（0x）或二进制（0b）整数
+    INTEGER,
+    // 含小数点或指数的十进制数
+    FLOAT
+};
+
+/**
+ * 词法分析时预先解析好的数字字面量值
+ *
+ * 数字Token在产生时即用 std::from_chars 解析，后续使用者无需再次解析词素文本。
+ * 在Token及TokenBuffer中压缩为 8 字节附加值加 1 字节标志位保存。
+ */
+struct NumberLiteral {
+    // 标志位：值为浮点数
+    static constexpr uint8_t kFloatFlag = 0x01;
+    // 标志位：值超出表示范围
+    static constexpr uint8_t kOutOfRangeFlag = 0x02;
+    // 标志位：浮点数丢失了字面量写出的有效数字
+    static constexpr uint8_t kInexactFlag = 0x04;
+
+    NumberKind kind = NumberKind::INTEGER;
+    // 字面量超出可表示范围：整数饱和为 INT64_MAX，浮点数上溢为无穷、下溢为 0
+    bool out_of_range = false;
+    // 十进制浮点字面量写出的有效数字多于 double 能保留的精度，值已被舍入到最接近的 double，
+    // 例如 123456789012345678901234567890.0 或 9007199254740993.0。
+    // 像 0.1 这样能从最短表示还原出原文的字面量不算丢失精度；超出范围时只设置 out_of_range
+    bool inexact = false;
+    union {
+        int64_t integer = 0;
+        double floating;
+    };
+
+    /**
+     * 按浮点数取值（整数会被转换）
+     */
+    [[nodiscard]] double toDouble() const {
+        return kind == NumberKind::FLOAT ? floating : static_cast<double>(integer);
+    }
+
+    /**
+     * 压缩后的 8 字节附加值（整数的补码或浮点数的位模式）
+     */
+    [[nodiscard]] uint64_t payload() const;
+
+    /**
+     * 压缩后的标志位
+     */
+    [[nodiscard]] uint8_t flags() const;
+
+    /**
+     * 从压缩形式还原
+     */
+    static NumberLiteral fromPayload(uint64_t payload, uint8_t flags);
+};
+
+/**
+ * 解析数字字面量的词素
+ *
+ * 词素必须已经通过词法分析器的格式检查：十进制整数/小数/指数形式，或 0x、0b 前缀的
+ * 整数，数字之间可以有单个 '_' 分隔符。
+ * @param text 数字词素
+ */
+NumberLiteral parseNumberLiteral(std::string_view text);
+
+} // namespace dreamlang::lexer
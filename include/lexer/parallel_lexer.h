@@ -0,0 +1,47 @@
+#pragma once
+
+#include "lexical.h"
+#include "token_buffer.h"
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 并行词法分析选项
+ */
+struct ParallelOptions {
+    // 工作线程数，0 表示使用硬件并发数
+    unsigned threads = 0;
+    // 每个分块的最小字节数，更小的输入不值得拆分
+    size_t min_chunk_size = 1 << 20;
+    // 使用的词法分析引擎
+    LexerEngine engine = LexerEngine::CLASSIC;
+    // 驻留标识符的符号表（可为空）；除第一个分块外，各分块先驻留到局部表，拼接时
+    // 按源码顺序转入，因此编号的分配顺序与顺序分析相同，也不会驻留实际并不存在的名字
+    SymbolTable* symbols = nullptr;
+    // 返回的Token缓冲区所用的内存资源（可为空，表示默认资源）；只在调用线程上使用，
+    // 各分块的中间结果仍使用默认资源
+    std::pmr::memory_resource* resource = nullptr;
+    // 源码起点在 SourceManager 中的位置（可为无效位置），抛出的异常据此携带 SourceLocation
+    SourceLocation file_start;
+};
+
+/**
+ * 并行分析单个源码缓冲区
+ *
+ * 源码在换行处切分为若干分块，每个分块由一个线程从分块起点开始分析，直到下一个
+ * Token越过分块终点。由于词法分析器在Token之间不保留状态，只要后一个分块在
+ * 前一个分块停下的位置恰好也有一个Token起点，其后的结果就与顺序分析一致；
+ * 分块起点落在字符串或块注释内部时则不会对齐，这部分会从确定的位置顺序重新分析。
+ * 所有线程共享同一份源码视图，因此各分块的偏移本身就是全局偏移，可以直接拼接。
+ *
+ * @param source 源码视图，必须比返回的缓冲区存活更久
+ * @param options 并行选项
+ * @return 与 Lexical(source).tokenize() 完全相同的Token序列
+ * @throws LexicalException 与顺序分析遇到的第一个错误相同
+ */
+TokenBuffer tokenizeParallel(std::string_view source, const ParallelOptions& options = {});
+
+} // namespace dreamlang::lexer
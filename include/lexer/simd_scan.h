@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dreamlang::lexer::simd {
+
+/**
+ * 向量化字节扫描内核
+ *
+ * 每个函数都在 data[pos, size) 范围内工作，找不到时返回 size。首次调用时按
+ * CPU 能力在 AVX2、SSE2 与标量实现之间选择，之后固定使用同一组实现。
+ */
+
+/**
+ * 查找字节 c 第一次出现的位置
+ */
+size_t findByte(const char* data, size_t pos, size_t size, char c);
+
+/**
+ * 查找字节 a 或 b 第一次出现的位置
+ */
+size_t findEitherByte(const char* data, size_t pos, size_t size, char a, char b);
+
+/**
+ * 跳过空格、制表符和回车，返回第一个其他字节的位置
+ */
+size_t skipBlanks(const char* data, size_t pos, size_t size);
+
+/**
+ * 统计字节 c 在 data[begin, end) 中出现的次数
+ */
+size_t countByte(const char* data, size_t begin, size_t end, char c);
+
+/**
+ * 把字节 c 在 data[0, size) 中每次出现的位置依次追加到 offsets
+ */
+void collectByteOffsets(const char* data, size_t size, char c, std::vector<uint32_t>& offsets);
+
+/**
+ * 验证 data[pos, size) 是否为合法的UTF-8（RFC 3629：拒绝过长编码、代理项和超出 U+10FFFF 的码点）
+ *
+ * pos 必须位于字符边界。
+ * @return 第一个非法序列的起始位置（末尾不完整的序列也算非法），全部合法时返回 size
+ */
+size_t validateUtf8(const char* data, size_t pos, size_t size);
+
+/**
+ * 当前选用的实现名称（"avx2"、"sse2" 或 "scalar"）
+ */
+const char* activeKernelName();
+
+} // namespace dreamlang::lexer::simd
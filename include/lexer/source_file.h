@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 只读源文件
+ *
+ * 普通文件通过 mmap 只读映射到内存，词法分析器直接在映射上工作，不产生拷贝；
+ * 管道、字符设备等无法映射的输入退回为一次性批量读取到内部缓冲区。
+ * 文件内容按原样提供，不做任何换行符转换（CRLF 由词法分析器处理）。
+ *
+ * SourceFile只可移动，不可拷贝；view() 返回的视图在对象销毁前有效。
+ */
+class SourceFile {
+public:
+    /**
+     * 打开并加载源文件
+     * @param path 文件路径
+     * @return 加载好的源文件
+     * @throws std::runtime_error 无法打开或读取文件
+     */
+    static SourceFile open(const std::string& path);
+
+    /**
+     * 从已打开的文件描述符加载（不负责关闭）
+     * @param fd 文件描述符
+     * @param name 用于错误消息的名称
+     * @throws std::runtime_error 读取失败
+     */
+    static SourceFile fromDescriptor(int fd, const std::string& name);
+
+    SourceFile(SourceFile&& other) noexcept;
+    SourceFile& operator=(SourceFile&& other) noexcept;
+    SourceFile(const SourceFile&) = delete;
+    SourceFile& operator=(const SourceFile&) = delete;
+
+    /**
+     * 析构函数，解除映射
+     */
+    ~SourceFile();
+
+    /**
+     * 获取文件内容
+     */
+    [[nodiscard]] std::string_view view() const { return {data_, size_}; }
+
+    /**
+     * 文件大小（字节）
+     */
+    [[nodiscard]] size_t size() const { return size_; }
+
+    /**
+     * 内容是否来自内存映射
+     */
+    [[nodiscard]] bool isMapped() const { return mapped_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    bool mapped_;
+    // 无法映射时保存批量读取的内容
+    std::string buffer_;
+
+    SourceFile();
+
+    /**
+     * 解除映射并清空
+     */
+    void release();
+};
+
+} // namespace dreamlang::lexer
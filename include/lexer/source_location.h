@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dreamlang::lexer {
+
+/**
+ * 压缩的源码位置
+ *
+ * 一个 32 位整数，表示 SourceManager 统一编址空间中的一个字节位置：各文件依次占据
+ * 空间中互不重叠的区间，位置减去文件区间的起点即为文件内的字节偏移。文件、行号和
+ * 列号都由 SourceManager 在需要时解码，位置本身只是一个整数，可以随Token、诊断和
+ * 异常廉价地复制和保存。0 表示无效位置（不属于任何文件）。
+ */
+class SourceLocation {
+public:
+    /**
+     * 构造无效位置
+     */
+    constexpr SourceLocation() = default;
+
+    /**
+     * 由原始编码构造
+     */
+    static constexpr SourceLocation fromRawEncoding(uint32_t raw) {
+        SourceLocation location;
+        location.raw_ = raw;
+        return location;
+    }
+
+    /**
+     * 获取原始编码
+     */
+    [[nodiscard]] constexpr uint32_t getRawEncoding() const { return raw_; }
+
+    /**
+     * 是否为有效位置
+     */
+    [[nodiscard]] constexpr bool isValid() const { return raw_ != 0; }
+
+    /**
+     * 获取同一文件中向后 offset 字节处的位置（无效位置仍为无效）
+     */
+    [[nodiscard]] constexpr SourceLocation getLocWithOffset(uint32_t offset) const {
+        return isValid() ? fromRawEncoding(raw_ + offset) : SourceLocation();
+    }
+
+    constexpr bool operator==(SourceLocation other) const { return raw_ == other.raw_; }
+    constexpr bool operator!=(SourceLocation other) const { return raw_ != other.raw_; }
+    constexpr bool operator<(SourceLocation other) const { return raw_ < other.raw_; }
+
+private:
+    uint32_t raw_ = 0;
+};
+
+static_assert(sizeof(SourceLocation) == sizeof(uint32_t), "SourceLocation must stay packed");
+
+} // namespace dreamlang::lexer
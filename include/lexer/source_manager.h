@@ -0,0 +1,132 @@
+#pragma once
+
+#include "line_index.h"
+#include "source_file.h"
+#include "source_location.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * SourceManager 中文件的编号，0 表示无效
+ */
+using FileId = uint32_t;
+
+/**
+ * 源码管理器：持有所有已加载的源码，并把它们编入同一个 32 位地址空间
+ *
+ * 每个文件占据地址空间中的一段区间 [起点, 起点 + 大小]（多出的一个位置表示文件末尾），
+ * 因此任一文件中的任一位置都可以用一个 SourceLocation 表示。文件、行号和列号在需要时
+ * 才解码：按区间起点二分查找文件，再用该文件的换行符索引（首次使用时构建）换算行列号。
+ *
+ * 线程安全：可以在多个线程中同时添加文件和查询位置。源码在管理器销毁前一直有效。
+ */
+class SourceManager {
+public:
+    SourceManager();
+
+    SourceManager(const SourceManager&) = delete;
+    SourceManager& operator=(const SourceManager&) = delete;
+
+    /**
+     * 添加一个已加载的文件（接管其所有权）
+     * @param name 文件名，用于显示位置
+     * @param file 已加载的源文件，添加失败时保持不变
+     * @return 文件编号
+     * @throws std::length_error 地址空间（4 GiB）已用尽
+     */
+    FileId addFile(std::string name, SourceFile&& file);
+
+    /**
+     * 添加一段内存中的源码（接管其所有权）
+     * @param name 显示用的名称
+     * @param contents 源码内容
+     * @return 文件编号
+     * @throws std::length_error 地址空间（4 GiB）已用尽
+     */
+    FileId addBuffer(std::string name, std::string contents);
+
+    /**
+     * 获取文件内容
+     */
+    [[nodiscard]] std::string_view getBuffer(FileId file) const;
+
+    /**
+     * 获取文件名
+     */
+    [[nodiscard]] const std::string& getFileName(FileId file) const;
+
+    /**
+     * 获取文件中字节偏移 offset（可以等于文件大小）处的位置
+     */
+    [[nodiscard]] SourceLocation getLocation(FileId file, size_t offset = 0) const;
+
+    /**
+     * 获取位置所在的文件，无效位置返回 0
+     */
+    [[nodiscard]] FileId getFileId(SourceLocation location) const;
+
+    /**
+     * 获取位置在其文件中的字节偏移
+     */
+    [[nodiscard]] size_t getFileOffset(SourceLocation location) const;
+
+    /**
+     * 把位置解码为行列号
+     */
+    [[nodiscard]] SourcePosition getPosition(SourceLocation location) const;
+
+    /**
+     * 把位置格式化为 "文件名:行:列"，无效位置返回空字符串
+     */
+    [[nodiscard]] std::string formatLocation(SourceLocation location) const;
+
+    /**
+     * 已添加的文件数
+     */
+    [[nodiscard]] size_t getFileCount() const;
+
+private:
+    struct Entry {
+        std::string name;
+        // 文件内容来自映射的文件或内存中的字符串
+        std::optional<SourceFile> file;
+        std::string contents;
+        std::string_view buffer;
+        // 文件在地址空间中的起点
+        uint32_t base = 0;
+        // 换行符索引，首次解码行列号时构建
+        mutable std::once_flag line_index_once;
+        mutable std::optional<LineIndex> line_index;
+    };
+
+    mutable std::shared_mutex mutex_;
+    // 按起点递增排列，下标为文件编号减一；Entry 单独分配，地址在添加新文件后不变
+    std::vector<std::unique_ptr<Entry>> entries_;
+    std::vector<uint32_t> bases_;
+    // 下一个文件的起点（0 保留为无效位置）
+    uint64_t next_base_;
+
+    /**
+     * 检查能否再容纳 size 字节的文件，返回其起点（调用方持有写锁）
+     * @throws std::length_error 地址空间已用尽
+     */
+    uint32_t nextBase(size_t size) const;
+
+    /**
+     * 登记起点已确定的文件（调用方持有写锁）
+     */
+    FileId insert(std::unique_ptr<Entry> entry);
+
+    const Entry& entry(FileId file) const;
+};
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "lexical.h"
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <string>
+
+namespace dreamlang::lexer {
+
+/**
+ * 流式词法分析器
+ *
+ * 从 std::istream 或文件描述符按固定大小的块读取源码，只在内存中保留一个
+ * 滑动窗口：已经产出的Token所在的前缀会在下次补充数据时丢弃。跨越块边界的
+ * Token（以及靠近窗口末尾、可能被后续数据延长的Token）会在补充数据后从其起点
+ * 重新分析，因此结果与一次性分析整个文件完全相同。
+ *
+ * 窗口装不下一个超长Token时，每次补充的数据量随窗口翻倍，重新分析的总代价与Token长度
+ * 成线性关系。峰值内存约为块大小加上最长的单个Token（或注释）长度的两倍，与文件大小无关。
+ * 返回的Token值只在下一次调用 nextToken() 之前有效。
+ */
+class StreamLexer {
+public:
+    /**
+     * 默认块大小
+     */
+    static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+    /**
+     * 从输入流构造
+     * @param input 输入流，必须比本对象存活更久
+     * @param chunk_size 每次读取的字节数
+     * @param engine 使用的词法分析引擎
+     */
+    explicit StreamLexer(std::istream& input, size_t chunk_size = kDefaultChunkSize,
+                         LexerEngine engine = LexerEngine::CLASSIC);
+
+    /**
+     * 从文件描述符构造（不负责关闭）
+     * @param fd 已打开的文件描述符
+     * @param chunk_size 每次读取的字节数
+     * @param engine 使用的词法分析引擎
+     */
+    explicit StreamLexer(int fd, size_t chunk_size = kDefaultChunkSize, LexerEngine engine = LexerEngine::CLASSIC);
+
+    StreamLexer(const StreamLexer&) = delete;
+    StreamLexer& operator=(const StreamLexer&) = delete;
+
+    /**
+     * 获取下一个Token
+     * @return 下一个Token，到达输入末尾时返回EOF Token；Token的偏移是窗口内的局部偏移，
+     *         全局位置请使用 getTokenOffset() / getTokenPosition()
+     * @throws LexicalException 词法错误（位置为全局行列号；流式输入不属于 SourceManager，不带 SourceLocation）
+     */
+    Token nextToken();
+
+    /**
+     * 设置用于驻留标识符的符号表（可为空），必须比本对象存活更久
+     */
+    void setSymbolTable(SymbolTable* symbols);
+
+    /**
+     * 最近一个Token的全局起始字节偏移
+     */
+    [[nodiscard]] uint64_t getTokenOffset() const { return token_offset_; }
+
+    /**
+     * 最近一个Token的全局行列位置（词素结束处，与 Token::getPosition 一致）
+     */
+    [[nodiscard]] SourcePosition getTokenPosition() const { return token_position_; }
+
+    /**
+     * 当前窗口的大小（用于观察内存占用）
+     */
+    [[nodiscard]] size_t getWindowSize() const { return window_.size(); }
+
+private:
+    std::istream* input_;
+    int fd_;
+    size_t chunk_size_;
+    LexerEngine engine_;
+    SymbolTable* symbols_;
+    bool eof_;
+
+    // 当前窗口及其在整个输入中的起点
+    std::string window_;
+    uint64_t window_offset_;
+    int window_line_;
+    int window_column_;
+
+    std::optional<Lexical> lexer_;
+    uint64_t token_offset_;
+    SourcePosition token_position_;
+
+    /**
+     * 丢弃窗口中 consumed 之前的部分，读入下一块数据，并在新窗口上重建词法分析器
+     */
+    void refill(size_t consumed);
+
+    /**
+     * 读取至多 size 字节到 buffer
+     * @return 实际读取的字节数，0 表示输入结束
+     */
+    size_t readChunk(char* buffer, size_t size);
+
+    /**
+     * 把窗口内的行列位置换算为全局位置
+     */
+    [[nodiscard]] SourcePosition toGlobal(SourcePosition local) const;
+};
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 标识符编号
+ */
+using SymbolId = uint32_t;
+
+/**
+ * 线程安全的标识符符号表
+ *
+ * 把标识符文本驻留为从 0 开始连续分配的编号，之后的阶段比较两个名字时只需比较整数。
+ * 同一张表可以在多个文件、多个线程的词法分析之间共享。
+ *
+ * 表按哈希值分为若干分片，每个分片是一张以名字字节为键、线性探测的开放寻址哈希表，
+ * 由各自的读写锁保护：已驻留的名字只需持有分片的共享锁即可查到。名字文本在首次驻留时
+ * 复制一份，因此编号及 name() 返回的视图与源码缓冲区的生命周期无关。
+ */
+class SymbolTable {
+public:
+    // 未驻留（词法分析器没有配置符号表）的标识符编号
+    static constexpr SymbolId kInvalidSymbol = 0xFFFFFFFF;
+
+    SymbolTable();
+
+    SymbolTable(const SymbolTable&) = delete;
+    SymbolTable& operator=(const SymbolTable&) = delete;
+
+    /**
+     * 驻留一个名字
+     * @param name 名字文本（不需要长期有效）
+     * @return 名字的编号，同一名字总是得到同一编号
+     * @throws std::length_error 编号耗尽
+     */
+    SymbolId intern(std::string_view name);
+
+    /**
+     * 查找已驻留的名字
+     * @return 名字的编号，未驻留时返回 kInvalidSymbol
+     */
+    [[nodiscard]] SymbolId find(std::string_view name) const;
+
+    /**
+     * 获取编号对应的名字
+     * @param id 由 intern() 返回的编号
+     */
+    [[nodiscard]] std::string_view name(SymbolId id) const;
+
+    /**
+     * 已驻留的名字数量
+     */
+    [[nodiscard]] size_t size() const;
+
+private:
+    // 哈希表的一个槽位，data 为空表示空槽
+    struct Slot {
+        const char* data = nullptr;
+        uint32_t length = 0;
+        uint32_t hash = 0;
+        SymbolId id = kInvalidSymbol;
+    };
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        // 容量总是 2 的幂
+        std::vector<Slot> slots;
+        size_t count = 0;
+        // 名字文本的副本，deque保证追加时元素地址不变
+        std::deque<std::string> storage;
+    };
+
+    static constexpr size_t kShardBits = 4;
+    static constexpr size_t kShardCount = size_t{1} << kShardBits;
+
+    std::array<Shard, kShardCount> shards_;
+
+    // 按编号索引的名字视图，编号在此锁下分配以保证连续
+    mutable std::shared_mutex names_mutex_;
+    std::vector<std::string_view> names_;
+
+    static uint32_t hashName(std::string_view name);
+
+    /**
+     * 探测名字所在的槽位下标，不存在时返回应插入的空槽
+     */
+    static size_t probe(const Shard& shard, std::string_view name, uint32_t hash);
+
+    /**
+     * 扩容一个分片并重新放置所有槽位
+     */
+    static void grow(Shard& shard);
+};
+
+} // namespace dreamlang::lexer
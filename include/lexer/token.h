@@ -1,43 +1,60 @@
 #pragma once
 
 #include "token_type.h"
+#include "line_index.h"
+#include "number_literal.h"
+#include "symbol_table.h"
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 namespace dreamlang::lexer {
 
 /**
  * Token类，表示词法分析的基本单元
+ *
+ * Token的值是一个视图，指向词法分析器持有的源码缓冲区（或其转义解码存储），
+ * 因此Token不得比产生它的Lexical实例存活更久。
+ *
+ * Token只记录词素在源码中的字节偏移和长度，行列号需要时通过 LineIndex 换算。
+ * 报告的位置是词素结束处（与早期版本直接记录的行列号一致）。
+ *
+ * 数字Token另外携带词法分析时解析好的值（8 字节附加值和标志位），见 getNumber()；
+ * 标识符Token的附加值是其在符号表中的编号，见 getSymbol()。
  */
 class Token {
 public:
     /**
      * 构造函数
      * @param type Token类型
-     * @param value Token值
-     * @param line 行号
-     * @param column 列号
+     * @param value Token值（不拷贝，调用方需保证其指向的存储足够长寿）
+     * @param offset 词素起始字节偏移
+     * @param length 词素字节长度
+     * @param payload 附加值（数字Token为压缩后的数值）
+     * @param flags 附加值的标志位
      */
-    Token(TokenType type, const std::string& value, int line, int column);
+    Token(TokenType type, std::string_view value, uint32_t offset, uint32_t length, uint64_t payload = 0,
+          uint8_t flags = 0);
 
     /**
      * 拷贝构造函数
      */
-    Token(const Token& other);
+    Token(const Token& other) = default;
 
     /**
      * 移动构造函数
      */
-    Token(Token&& other) noexcept;
+    Token(Token&& other) noexcept = default;
 
     /**
      * 赋值操作符
      */
-    Token& operator=(const Token& other);
+    Token& operator=(const Token& other) = default;
 
     /**
      * 移动赋值操作符
      */
-    Token& operator=(Token&& other) noexcept;
+    Token& operator=(Token&& other) noexcept = default;
 
     /**
      * 析构函数
@@ -46,14 +63,34 @@ public:
 
     // Getter方法
     TokenType getType() const { return type_; }
-    const std::string& getValue() const { return value_; }
-    int getLine() const { return line_; }
-    int getColumn() const { return column_; }
+    std::string_view getValue() const { return value_; }
+    uint32_t getOffset() const { return offset_; }
+    uint32_t getLength() const { return length_; }
+    uint32_t getEndOffset() const { return offset_ + length_; }
+    uint64_t getPayload() const { return payload_; }
+    uint8_t getFlags() const { return flags_; }
+
+    /**
+     * 获取数字Token预先解析好的值（仅对 NUMBER 类型有意义）
+     */
+    NumberLiteral getNumber() const { return NumberLiteral::fromPayload(payload_, flags_); }
+
+    /**
+     * 获取标识符Token的符号编号（仅对 IDENT 类型有意义；词法分析器未配置符号表时为
+     * SymbolTable::kInvalidSymbol）
+     */
+    SymbolId getSymbol() const { return static_cast<SymbolId>(payload_); }
+
+    /**
+     * 获取Token的行列位置
+     * @param line_index 源码的换行符索引
+     */
+    SourcePosition getPosition(const LineIndex& line_index) const { return line_index.resolve(getEndOffset()); }
 
     /**
      * 检查是否是关键字
      */
-    bool isKeyword() const { return type_ == TokenType::KEYWORD; }
+    bool isKeyword() const { return isKeywordType(type_); }
 
     /**
      * 检查是否是操作符
@@ -66,10 +103,22 @@ public:
     bool isLiteral() const;
 
     /**
-     * 获取Token的字符串表示
+     * 获取Token的字符串表示（位置以字节偏移表示）
      */
     std::string toString() const;
 
+    /**
+     * 获取Token的字符串表示（位置以行列号表示）
+     * @param line_index 源码的换行符索引
+     */
+    std::string toString(const LineIndex& line_index) const;
+
+    /**
+     * 获取Token的字符串表示（使用已经换算好的行列位置）
+     * @param position Token的行列位置
+     */
+    std::string toString(const SourcePosition& position) const;
+
     /**
      * 等于操作符
      */
@@ -81,10 +130,12 @@ public:
     bool operator!=(const Token& other) const;
 
 private:
+    std::string_view value_;
+    uint64_t payload_;
+    uint32_t offset_;
+    uint32_t length_;
     TokenType type_;
-    std::string value_;
-    int line_;
-    int column_;
+    uint8_t flags_;
 };
 
 } // namespace dreamlang::lexer
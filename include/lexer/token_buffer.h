@@ -0,0 +1,254 @@
+#pragma once
+
+#include "token.h"
+#include "line_index.h"
+#include "util/arena.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 紧凑的Token序列（结构数组布局）
+ *
+ * 每个Token占用 1 字节类型 + 4 字节偏移 + 4 字节长度，偏移和长度描述的是Token在源码中的
+ * 完整词素（字符串/字符字面量包含引号）。Token值由源码切片得到，只有含转义的字面量才在缓冲区
+ * 内部保存解码后的副本。数字Token预先解析好的数值和标识符的符号编号同样存放在按下标排列的
+ * 稀疏附表中，只有附加值不等于默认值（数值 0、kInvalidSymbol）的Token才占用附表。行列号在
+ * 需要时通过 LineIndex 按需计算。
+ *
+ * TokenBuffer引用源码缓冲区而不拷贝，源码必须比TokenBuffer存活更久。缓冲区只能移动，
+ * 不能拷贝。
+ *
+ * 各数组与解码值的字节都从构造时给定的 std::pmr::memory_resource 分配。交给它一个
+ * 按会话存活的竞技场（util::Arena）时，分析一个文件只需向系统申请少数几次内存，
+ * 缓冲区的全部内存也随竞技场一次释放；此时竞技场必须比缓冲区存活更久。
+ */
+class TokenBuffer {
+public:
+    /**
+     * 按值产出Token的只读迭代器
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Token;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Token;
+
+        const_iterator() = default;
+        const_iterator(const TokenBuffer* buffer, size_t index) : buffer_(buffer), index_(index) {}
+
+        Token operator*() const { return (*buffer_)[index_]; }
+
+        const_iterator& operator++() {
+            ++index_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+        /**
+         * 获取当前位置的下标
+         */
+        size_t index() const { return index_; }
+
+    private:
+        const TokenBuffer* buffer_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    /**
+     * 构造函数
+     * @param source 源码视图（不拷贝）
+     * @param resource 分配内存所用的资源，必须比缓冲区存活更久
+     */
+    explicit TokenBuffer(std::string_view source = {},
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * 追加一个Token
+     * @param type Token类型
+     * @param offset 词素起始字节偏移
+     * @param length 词素字节长度
+     * @param value Token值；若它不是源码中的对应切片（即经过转义解码），则保存副本
+     * @param payload 附加值
+     * @param flags 附加值的标志位
+     */
+    void push(TokenType type, size_t offset, size_t length, std::string_view value, uint64_t payload = 0,
+              uint8_t flags = 0);
+
+    /**
+     * 追加一个Token（连同其附加值）
+     */
+    void push(const Token& token) {
+        push(token.getType(), token.getOffset(), token.getLength(), token.getValue(), token.getPayload(),
+             token.getFlags());
+    }
+
+    /**
+     * 追加另一个缓冲区中从 first 开始的全部Token
+     * @param other 引用同一份源码的Token缓冲区（偏移无需换算）
+     * @param first 起始下标
+     */
+    void append(const TokenBuffer& other, size_t first = 0);
+
+    /**
+     * 用 replacement 中的Token替换 [first, last) 区间，用于增量重新分析
+     *
+     * 缓冲区改为引用编辑后的源码，last 之后的Token偏移整体平移 offset_delta，
+     * 已构建的换行符索引同步更新。之前取得的Token值视图全部失效。
+     * @param first 被替换区间的起始下标
+     * @param last 被替换区间的结束下标（不含）
+     * @param replacement 引用编辑后源码的新Token
+     * @param new_source 编辑后的源码
+     * @param edit_offset 编辑起点
+     * @param old_length 被替换的旧文本长度
+     * @param new_length 替换进来的新文本长度
+     */
+    void replaceRange(size_t first, size_t last, const TokenBuffer& replacement, std::string_view new_source,
+                      size_t edit_offset, size_t old_length, size_t new_length);
+
+    /**
+     * 预留容量
+     */
+    void reserve(size_t count);
+
+    /**
+     * 清空所有Token（保留容量）
+     */
+    void clear();
+
+    /**
+     * 清空所有Token并改为引用另一份源码（保留容量），用于复用缓冲区分析新的输入
+     */
+    void reset(std::string_view source);
+
+    /**
+     * Token数量
+     */
+    [[nodiscard]] size_t size() const { return kinds_.size(); }
+
+    /**
+     * 是否为空
+     */
+    [[nodiscard]] bool empty() const { return kinds_.empty(); }
+
+    /**
+     * 获取第 index 个Token的类型
+     */
+    [[nodiscard]] TokenType type(size_t index) const { return static_cast<TokenType>(kinds_[index]); }
+
+    /**
+     * 获取第 index 个Token词素的起始偏移
+     */
+    [[nodiscard]] uint32_t offset(size_t index) const { return offsets_[index]; }
+
+    /**
+     * 获取第 index 个Token词素的长度
+     */
+    [[nodiscard]] uint32_t length(size_t index) const { return lengths_[index]; }
+
+    /**
+     * 获取第 index 个Token的值
+     */
+    [[nodiscard]] std::string_view value(size_t index) const;
+
+    /**
+     * 获取第 index 个Token预先解析好的数值（仅对 NUMBER 类型有意义）
+     */
+    [[nodiscard]] NumberLiteral number(size_t index) const;
+
+    /**
+     * 获取第 index 个Token的符号编号（仅对 IDENT 类型有意义）
+     */
+    [[nodiscard]] SymbolId symbol(size_t index) const;
+
+    /**
+     * 获取第 index 个Token的行号（与Token相同，为词素结束处的位置）
+     */
+    [[nodiscard]] int line(size_t index) const;
+
+    /**
+     * 获取第 index 个Token的列号（与Token相同，为词素结束处的位置）
+     */
+    [[nodiscard]] int column(size_t index) const;
+
+    /**
+     * 物化第 index 个Token
+     */
+    Token operator[](size_t index) const;
+
+    /**
+     * 获取源码的换行符索引（首次调用时构建）
+     */
+    const LineIndex& lineIndex() const;
+
+    /**
+     * 获取引用的源码
+     */
+    [[nodiscard]] std::string_view source() const { return source_; }
+
+    /**
+     * 获取分配内存所用的资源
+     */
+    [[nodiscard]] std::pmr::memory_resource* resource() const { return kinds_.get_allocator().resource(); }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+
+private:
+    // 磁盘缓存直接整块读写各数组
+    friend class TokenCache;
+
+    std::string_view source_;
+    std::pmr::vector<uint8_t> kinds_;
+    std::pmr::vector<uint32_t> offsets_;
+    std::pmr::vector<uint32_t> lengths_;
+
+    // 附加值不等于默认值的Token的下标（递增）及其附加值和标志位
+    std::pmr::vector<uint32_t> payload_indices_;
+    std::pmr::vector<uint64_t> payloads_;
+    std::pmr::vector<uint8_t> flags_;
+
+    // 含转义字面量的下标（递增）及其解码值，解码值的字节存放在竞技场中
+    std::pmr::vector<uint32_t> decoded_indices_;
+    std::pmr::vector<std::string_view> decoded_values_;
+    util::Arena decoded_arena_;
+
+    // 换行符索引，首次查询行列号时构建
+    mutable std::optional<LineIndex> line_index_;
+
+    /**
+     * 该类型Token不占用附表时的附加值（标识符为 kInvalidSymbol，其他为 0）
+     */
+    static uint64_t defaultPayload(TokenType type) {
+        return type == TokenType::IDENT ? SymbolTable::kInvalidSymbol : 0;
+    }
+
+    /**
+     * 查找第 index 个Token在附表中的位置，不在附表中时返回附表大小
+     */
+    [[nodiscard]] size_t findPayload(size_t index) const;
+
+    /**
+     * 不经解码时该Token在源码中对应的值
+     */
+    [[nodiscard]] std::string_view sourceValue(TokenType type, uint32_t offset, uint32_t length) const;
+};
+
+} // namespace dreamlang::lexer
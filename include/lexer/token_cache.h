@@ -0,0 +1,70 @@
+#pragma once
+
+#include "token_buffer.h"
+#include "symbol_table.h"
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 磁盘上的Token缓存
+ *
+ * 以源码内容的哈希为键，把分析结果以紧凑的二进制形式（与 TokenBuffer 相同的结构数组
+ * 布局）保存在缓存目录中，每份内容一个文件。命中时通过 mmap 映射缓存文件并整块复制
+ * 各数组，不需要重新分析。缓存只依赖源码内容，与文件路径无关；词法规则变化时
+ * （Lexical::kRulesVersion 递增）旧的缓存自动失效。
+ *
+ * 标识符的符号编号不写入缓存，加载时按需重新驻留到调用方的符号表。
+ * 缓存是尽力而为的：读写失败、文件损坏或版本不符都只当作未命中处理，从不抛出异常。
+ * 多个线程或进程可以同时读写同一缓存目录（写入先写临时文件再原子地改名）。
+ */
+class TokenCache {
+public:
+    /**
+     * 构造函数（目录在首次写入时创建）
+     * @param directory 缓存目录
+     */
+    explicit TokenCache(std::string directory);
+
+    /**
+     * 查找源码对应的缓存
+     * @param source 源码，返回的缓冲区引用它
+     * @param symbols 用于重新驻留标识符的符号表（可为空）
+     * @param resource 返回的缓冲区所用的内存资源
+     * @return 与 Lexical(source).tokenize() 相同的Token序列，未命中时为空
+     */
+    std::optional<TokenBuffer> load(std::string_view source, SymbolTable* symbols = nullptr,
+                                    std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+    /**
+     * 保存源码的分析结果
+     * @param source 源码
+     * @param tokens 对 source 完整分析得到的Token序列
+     * @return 是否写入成功
+     */
+    bool store(std::string_view source, const TokenBuffer& tokens) const;
+
+    /**
+     * 缓存目录
+     */
+    [[nodiscard]] const std::string& directory() const { return directory_; }
+
+    /**
+     * 计算源码内容的 64 位哈希（XXH64 算法）
+     */
+    static uint64_t hashContent(std::string_view content);
+
+private:
+    std::string directory_;
+
+    /**
+     * 内容哈希对应的缓存文件路径
+     */
+    [[nodiscard]] std::string entryPath(uint64_t hash) const;
+};
+
+} // namespace dreamlang::lexer
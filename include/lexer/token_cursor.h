@@ -0,0 +1,106 @@
+#pragma once
+
+#include "lexical.h"
+#include "token.h"
+#include <cstddef>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 按需拉取Token的游标，带有固定容量的环形前瞻缓冲区
+ *
+ * 游标只在 peek()/advance() 需要时才调用词法分析器，最近分析出的至多 capacity 个Token
+ * 保存在环形缓冲区中：既用于向前查看，也用于回退。内存占用与源码大小无关，适合
+ * 需要有限前瞻和回溯的语法分析器。
+ *
+ * mark() 记录当前位置，rewind() 回到记录的位置：若该位置的Token仍在缓冲区中，只需
+ * 移动读指针；否则把词法分析器 seek() 回该Token的起点重新分析（词法分析器在Token之间
+ * 不保留状态，结果与第一次相同）。重新分析时，恢复模式下的诊断会再次记录。
+ *
+ * 返回的Token值与直接调用 Lexical::nextToken() 得到的一样引用词法分析器的存储。
+ */
+class TokenCursor {
+public:
+    /**
+     * 默认缓冲区容量
+     */
+    static constexpr size_t kDefaultCapacity = 16;
+
+    /**
+     * 游标位置的检查点，由 mark() 返回
+     */
+    struct Mark {
+        // 该位置之前已消费的Token数
+        size_t index;
+        // 该位置Token（或其前面空白）的起始字节偏移
+        size_t offset;
+    };
+
+    /**
+     * 构造函数
+     * @param lexer 词法分析器，必须比游标存活更久，且不应再被其他代码直接驱动
+     * @param capacity 缓冲区容量（向上取整为 2 的幂），决定最大前瞻距离和免重分析的回退距离
+     */
+    explicit TokenCursor(Lexical& lexer, size_t capacity = kDefaultCapacity);
+
+    TokenCursor(const TokenCursor&) = delete;
+    TokenCursor& operator=(const TokenCursor&) = delete;
+
+    /**
+     * 查看当前位置之后第 n 个Token（0 为当前Token），不消费
+     *
+     * 越过EOF之后总是得到EOF Token。
+     * @throws std::out_of_range n 不小于缓冲区容量
+     * @throws LexicalException 词法错误（游标位置不变）
+     */
+    const Token& peek(size_t n = 0);
+
+    /**
+     * 消费并返回当前Token；位于EOF时停留在EOF
+     * @throws LexicalException 词法错误（游标位置不变）
+     */
+    Token advance();
+
+    /**
+     * 当前Token是否为EOF
+     */
+    bool atEnd() { return peek().getType() == TokenType::EOF_TOKEN; }
+
+    /**
+     * 记录当前位置
+     */
+    [[nodiscard]] Mark mark() const;
+
+    /**
+     * 回到 mark() 记录的位置（可以是当前位置之前或之后的任一检查点）
+     */
+    void rewind(const Mark& checkpoint);
+
+    /**
+     * 已消费的Token数
+     */
+    [[nodiscard]] size_t position() const { return position_; }
+
+    /**
+     * 缓冲区容量
+     */
+    [[nodiscard]] size_t capacity() const { return ring_.size(); }
+
+private:
+    Lexical& lexer_;
+    // 容量为 2 的幂，第 i 个Token存放在 ring_[i & mask_]
+    std::vector<Token> ring_;
+    size_t mask_;
+    // 缓冲区中Token的编号区间 [begin_, end_)，begin_ <= position_ <= end_
+    size_t begin_;
+    size_t end_;
+    size_t position_;
+
+    /**
+     * 确保编号为 index 的Token已在缓冲区中
+     */
+    void fill(size_t index);
+};
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "lexical.h"
+#include "source_location.h"
+#include "token_type.h"
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace dreamlang::lexer {
+
+/**
+ * 各类型Token的数量
+ */
+struct TokenStatistics {
+    // Token总数（含换行Token和EOF Token，与 Lexical::tokenize() 返回的缓冲区大小一致）
+    size_t total = 0;
+    // 按 TokenType 的取值索引的数量
+    std::array<size_t, kTokenTypeCount> by_type{};
+
+    /**
+     * 获取某一类型的Token数量
+     */
+    [[nodiscard]] size_t count(TokenType type) const { return by_type[static_cast<size_t>(type)]; }
+};
+
+/**
+ * 统计源码中的Token数量
+ *
+ * 直接从扫描器计数，不记录位置和值，也不构建Token缓冲区，分析过程中不分配内存
+ * （出错和驻留新的标识符时除外）。结果与 Lexical(source, engine).tokenize().size() 相同。
+ * @param source 源码视图
+ * @param engine 使用的词法分析引擎
+ * @param symbols 驻留标识符的符号表（可为空），驻留的结果与 Lexical 相同
+ * @param file_start 源码起点在 SourceManager 中的位置，异常据此携带 SourceLocation
+ * @return Token总数
+ * @throws LexicalException 与 Lexical 遇到的第一个错误相同
+ */
+size_t countTokens(std::string_view source, LexerEngine engine = LexerEngine::CLASSIC,
+                   SymbolTable* symbols = nullptr, SourceLocation file_start = SourceLocation());
+
+/**
+ * 按类型统计源码中的Token数量，其余同 countTokens()
+ */
+TokenStatistics collectTokenStatistics(std::string_view source, LexerEngine engine = LexerEngine::CLASSIC,
+                                       SymbolTable* symbols = nullptr, SourceLocation file_start = SourceLocation());
+
+} // namespace dreamlang::lexer
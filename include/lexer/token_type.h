@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 namespace dreamlang::lexer {
 
 /**
- * Token类型枚举
+ * Token类型枚举（单字节存储，便于紧凑的Token缓冲区）
  */
-enum class TokenType {
+enum class TokenType : uint8_t {
     IDENT,
     NULL_LITERAL,
     NUMBER,
@@ -17,8 +20,38 @@ enum class TokenType {
     SINGLE_COMMENT,
     // 多行注释
     MULTI_COMMENT,
-    // 关键字
-    KEYWORD,
+    // 关键字（每个关键字一个类型，KW_BOOL 到 KW_ABSTRACT 连续排列）
+    KW_BOOL,
+    KW_NUMBER,
+    KW_CHAR,
+    KW_STRING,
+    KW_FUNCTION,
+    KW_ARRAY,
+    KW_CLASS,
+    KW_OBJECT,
+    KW_REFERENCE,
+    KW_PACKAGE,
+    KW_IMPORT,
+    KW_VAR,
+    KW_VAL,
+    KW_REF,
+    KW_RETURN,
+    KW_FUN,
+    KW_IF,
+    KW_ELSE,
+    KW_FOR,
+    KW_WHILE,
+    KW_BREAK,
+    KW_CONTINUE,
+    KW_SWITCH,
+    KW_CASE,
+    KW_DEFAULT,
+    KW_SUPER,
+    KW_THIS,
+    KW_AVAILABLE,
+    KW_IN,
+    KW_INTERFACE,
+    KW_ABSTRACT,
     // 赋值
     ASSIGN,
     // 加
@@ -73,10 +106,24 @@ enum class TokenType {
     LEFT_BRACE,
     // 右大括号
     RIGHT_BRACE,
+    // 错误恢复模式下无法识别的片段
+    ERROR,
     // 文件结束
     EOF_TOKEN
 };
 
+/**
+ * Token类型的数量
+ */
+constexpr size_t kTokenTypeCount = static_cast<size_t>(TokenType::EOF_TOKEN) + 1;
+
+/**
+ * 检查类型是否为关键字
+ */
+constexpr bool isKeywordType(TokenType type) {
+    return type >= TokenType::KW_BOOL && type <= TokenType::KW_ABSTRACT;
+}
+
 /**
  * 将TokenType转换为字符串表示
  * @param type Token类型
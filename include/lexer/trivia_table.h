@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+/**
+ * 琐碎内容（不产生Token的源码片段）的种类
+ */
+enum class TriviaKind : uint8_t {
+    // 一段连续的空格、制表符和回车
+    WHITESPACE,
+    // 换行符（仅在策略不产生 LINEBREAK Token 时记录）
+    NEWLINE,
+    // 单行注释 // ...（不含结尾的换行符）
+    LINE_COMMENT,
+    // 多行注释 /* ... */
+    BLOCK_COMMENT
+};
+
+/**
+ * 琐碎内容的旁路表（结构数组布局）
+ *
+ * 与Token序列分开保存空白和注释的位置，每项 1 字节种类 + 4 字节偏移 + 4 字节长度 +
+ * 4 字节Token下标，按源码顺序排列。Token下标指向紧跟在这段内容之后的Token，因此
+ * 某个Token前面的全部空白和注释是表中连续的一段（见 leading()），格式化、文档等工具
+ * 不需要再次分析源码。
+ *
+ * 表引用源码缓冲区而不拷贝，源码必须比表存活更久。
+ */
+class TriviaTable {
+public:
+    /**
+     * 构造函数
+     * @param source 源码视图（不拷贝）
+     * @param resource 分配内存所用的资源，必须比表存活更久
+     */
+    explicit TriviaTable(std::string_view source = {},
+                         std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    /**
+     * 追加一项（token_index 必须不小于最后一项的Token下标）
+     * @param kind 种类
+     * @param offset 起始字节偏移
+     * @param length 字节长度
+     * @param token_index 其后第一个Token的下标
+     */
+    void push(TriviaKind kind, size_t offset, size_t length, size_t token_index) {
+        kinds_.push_back(static_cast<uint8_t>(kind));
+        offsets_.push_back(static_cast<uint32_t>(offset));
+        lengths_.push_back(static_cast<uint32_t>(length));
+        token_indices_.push_back(static_cast<uint32_t>(token_index));
+    }
+
+    /**
+     * 清空所有项（保留容量）
+     */
+    void clear();
+
+    /**
+     * 清空所有项并改为引用另一份源码（保留容量）
+     */
+    void reset(std::string_view source) {
+        clear();
+        source_ = source;
+    }
+
+    /**
+     * 项数
+     */
+    [[nodiscard]] size_t size() const { return kinds_.size(); }
+
+    /**
+     * 是否为空
+     */
+    [[nodiscard]] bool empty() const { return kinds_.empty(); }
+
+    /**
+     * 获取第 index 项的种类
+     */
+    [[nodiscard]] TriviaKind kind(size_t index) const { return static_cast<TriviaKind>(kinds_[index]); }
+
+    /**
+     * 获取第 index 项的起始偏移
+     */
+    [[nodiscard]] uint32_t offset(size_t index) const { return offsets_[index]; }
+
+    /**
+     * 获取第 index 项的长度
+     */
+    [[nodiscard]] uint32_t length(size_t index) const { return lengths_[index]; }
+
+    /**
+     * 获取第 index 项之后第一个Token的下标
+     */
+    [[nodiscard]] uint32_t tokenIndex(size_t index) const { return token_indices_[index]; }
+
+    /**
+     * 获取第 index 项的源码文本
+     */
+    [[nodiscard]] std::string_view text(size_t index) const {
+        return source_.substr(offsets_[index], lengths_[index]);
+    }
+
+    /**
+     * 查找第 token_index 个Token前面的琐碎内容
+     * @return 表中的下标区间 [first, last)，没有时为空区间
+     */
+    [[nodiscard]] std::pair<size_t, size_t> leading(size_t token_index) const;
+
+    /**
+     * 获取引用的源码
+     */
+    [[nodiscard]] std::string_view source() const { return source_; }
+
+private:
+    std::string_view source_;
+    std::pmr::vector<uint8_t> kinds_;
+    std::pmr::vector<uint32_t> offsets_;
+    std::pmr::vector<uint32_t> lengths_;
+    // 按源码顺序排列，因此单调不减
+    std::pmr::vector<uint32_t> token_indices_;
+};
+
+} // namespace dreamlang::lexer
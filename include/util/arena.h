@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+namespace dreamlang::util {
+
+/**
+ * 按块分配的字节竞技场（bump allocator）
+ *
+ * 分配只是在当前块内移动指针，当前块放不下时再向上游资源申请新块；所有内存在竞技场
+ * 析构或 reset() 时一次性释放，单个分配不能单独释放。已分配的内存地址在竞技场
+ * 存活期间保持不变，适合存放大量生命周期相同的小字符串。
+ *
+ * 竞技场同时是一个单调的 std::pmr::memory_resource，可以作为一次词法分析会话的
+ * 内存资源交给 std::pmr 容器使用：容器释放内存时什么也不做，全部内存随竞技场一起释放。
+ * 竞技场不是线程安全的。
+ */
+class Arena : public std::pmr::memory_resource {
+public:
+    /**
+     * 默认块大小
+     */
+    static constexpr size_t kDefaultBlockSize = 16 * 1024;
+
+    /**
+     * 构造函数（不预先分配内存）
+     * @param block_size 每块的字节数，超过半块的分配单独占用一块
+     * @param upstream 申请块所用的上游资源，必须比竞技场存活更久
+     */
+    explicit Arena(size_t block_size = kDefaultBlockSize,
+                   std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * 移动构造（仍被 std::pmr 容器引用的竞技场不能移动）
+     */
+    Arena(Arena&& other) noexcept;
+    Arena& operator=(Arena&& other) noexcept;
+
+    ~Arena() override;
+
+    /**
+     * 分配 size 字节（不对齐，用于字符数据）
+     */
+    char* allocate(size_t size);
+
+    /**
+     * 把最近一次分配从 old_size 缩小到 new_size，归还尾部未用的字节
+     *
+     * 用于先按上界分配、写入后才知道实际长度的场合；data 不是最近一次分配时不做任何事。
+     */
+    void shrink(char* data, size_t old_size, size_t new_size);
+
+    /**
+     * 复制一段文本到竞技场
+     * @return 指向竞技场内副本的视图
+     */
+    std::string_view copy(std::string_view text);
+
+    /**
+     * 释放所有分配，保留最后一个普通块以便复用
+     */
+    void reset();
+
+    /**
+     * 向上游资源申请的总字节数
+     */
+    [[nodiscard]] size_t capacity() const { return capacity_; }
+
+    /**
+     * 向上游资源申请块的次数（reset() 不清零）
+     */
+    [[nodiscard]] size_t blockAllocations() const { return block_allocations_; }
+
+    /**
+     * 申请块所用的上游资源
+     */
+    [[nodiscard]] std::pmr::memory_resource* upstream() const { return upstream_; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        char* data;
+        size_t size;
+        size_t alignment;
+    };
+
+    size_t block_size_;
+    std::pmr::memory_resource* upstream_;
+    std::vector<Block> blocks_;
+    // 当前块的可用区间
+    char* cursor_;
+    char* end_;
+    size_t capacity_;
+    size_t block_allocations_;
+
+    /**
+     * 向上游资源申请一块 size 字节的新块（不切换当前块）
+     */
+    char* newBlock(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * 把所有块归还上游资源
+     */
+    void releaseBlocks();
+};
+
+} // namespace dreamlang::util
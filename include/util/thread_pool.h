@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dreamlang::util {
+
+/**
+ * 工作窃取线程池
+ *
+ * 每个工作线程拥有自己的任务队列：外部提交的任务轮流分配到各个队列，工作线程
+ * 提交的子任务放入自己的队列。线程优先从自己队列的头部取任务，空闲时从其他
+ * 线程队列的尾部窃取，因此任务耗时差异很大时负载依然均衡。
+ */
+class ThreadPool {
+public:
+    /**
+     * 构造函数
+     * @param thread_count 工作线程数，0 表示使用硬件并发数
+     */
+    explicit ThreadPool(size_t thread_count = 0);
+
+    /**
+     * 析构函数，执行完所有已提交的任务后退出
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * 提交任务
+     * @param task 可调用对象
+     * @return 任务结果；任务抛出的异常会在 get() 时重新抛出
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using Result = std::invoke_result_t<std::decay_t<F>>;
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        enqueue([packaged]() { (*packaged)(); });
+        return future;
+    }
+
+    /**
+     * 等待所有已提交的任务执行完毕
+     */
+    void wait();
+
+    /**
+     * 工作线程数
+     */
+    [[nodiscard]] size_t size() const { return workers_.size(); }
+
+private:
+    // 单个工作线程的任务队列
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex state_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+    // 已提交但尚未被取走的任务数（受 state_mutex_ 保护，先于任务入队递增）
+    size_t queued_;
+    // 尚未执行完毕的任务数（受 state_mutex_ 保护）
+    size_t unfinished_;
+    // 外部提交时轮流选择的队列
+    std::atomic<size_t> next_queue_;
+    bool stopping_;
+
+    /**
+     * 把任务放入队列并唤醒一个工作线程
+     */
+    void enqueue(std::function<void()> task);
+
+    /**
+     * 从自己的队列头部取任务，失败时从其他队列尾部窃取
+     */
+    bool takeTask(size_t index, std::function<void()>& task);
+
+    /**
+     * 工作线程主循环
+     */
+    void workerLoop(size_t index);
+};
+
+} // namespace dreamlang::util
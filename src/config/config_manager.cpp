@@ -157,6 +157,14 @@ bool ConfigManager::createDefaultConfig(const std::string& config_path) {
     file << "    \"verbose\": false,\n";
     file << "    \"show_progress\": true,\n";
     file << "    \"colored_output\": true\n";
+    file << "  },\n";
+    file << "  \"lexer\": {\n";
+    file << "    \"engine\": \"classic\",\n";
+    file << "    \"stream_chunk_size\": 65536,\n";
+    file << "    \"jobs\": 0,\n";
+    file << "    \"error_recovery\": false,\n";
+    file << "    \"token_cache\": false,\n";
+    file << "    \"token_cache_dir\": \"\"\n";
     file << "  }\n";
     file << "}\n";
     
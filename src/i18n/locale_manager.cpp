@@ -1,5 +1,8 @@
 #include "i18n/locale_manager.h"
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
 
 namespace dreamlang::i18n {
 LocaleManager& LocaleManager::getInstance() {
@@ -8,7 +11,8 @@ LocaleManager& LocaleManager::getInstance() {
 }
 
 bool LocaleManager::initialize(const std::string& domain, const std::string& locale_dir) {
-    catalog_ = std::make_unique<MessageCatalog>(domain, locale_dir);
+    // 先在锁外加载完整的消息目录，再整体替换，查询方不会看到加载了一半的目录
+    auto catalog = std::make_unique<MessageCatalog>(domain, locale_dir);
     
     // 尝试从环境变量获取本地化设置
     const char* env_lang = std::getenv("LANG");
@@ -33,15 +37,18 @@ bool LocaleManager::initialize(const std::string& domain, const std::string& loc
     }
     
     // 尝试设置语言环境
-    if (!catalog_->setLocale(locale)) {
+    if (!catalog->setLocale(locale)) {
         // 如果设置失败，尝试英文
-        catalog_->setLocale("en_US");
+        catalog->setLocale("en_US");
     }
     
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    catalog_ = std::move(catalog);
     return true;
 }
 
 bool LocaleManager::setLocale(const std::string& locale) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
     if (!catalog_) {
         return false;
     }
@@ -50,6 +57,7 @@ bool LocaleManager::setLocale(const std::string& locale) {
 }
 
 std::string LocaleManager::gettext(const std::string& msgid) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!catalog_) {
         return msgid;
     }
@@ -60,6 +68,7 @@ std::string LocaleManager::gettext(const std::string& msgid) const {
 std::string LocaleManager::getPluralText(const std::string& msgid, 
                                          const std::string& msgid_plural, 
                                          int n) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     if (!catalog_) {
         return (n == 1) ? msgid : msgid_plural;
     }
@@ -67,4 +76,9 @@ std::string LocaleManager::getPluralText(const std::string& msgid,
     return catalog_->getPluralMessage(msgid, msgid_plural, n);
 }
 
+bool LocaleManager::isInitialized() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return catalog_ != nullptr;
+}
+
 } // namespace dreamlang::i18n
@@ -0,0 +1,78 @@
+#include "lexer/incremental_lexer.h"
+
+namespace dreamlang::lexer {
+
+namespace {
+
+/**
+ * 第一个结尾（加上前瞻）触及 offset 的Token下标，之前的Token都不受编辑影响
+ */
+size_t firstAffectedToken(const TokenBuffer& tokens, size_t offset) {
+    size_t low = 0;
+    size_t high = tokens.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (static_cast<size_t>(tokens.offset(mid)) + tokens.length(mid) + Lexical::kMaxLookahead <= offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+/**
+ * 在 [from, size) 中查找起点恰好为 offset 的Token，找不到时返回 size
+ */
+size_t findTokenStart(const TokenBuffer& tokens, size_t from, size_t offset) {
+    size_t low = from;
+    size_t high = tokens.size();
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (tokens.offset(mid) < offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < tokens.size() && tokens.offset(low) == offset ? low : tokens.size();
+}
+
+} // namespace
+
+TokenChange relexEdit(TokenBuffer& tokens, std::string_view new_source, const SourceEdit& edit,
+                      LexerEngine engine, SymbolTable* symbols) {
+    size_t first = firstAffectedToken(tokens, edit.offset);
+    size_t restart = first > 0 ? static_cast<size_t>(tokens.offset(first - 1)) + tokens.length(first - 1) : 0;
+    size_t edit_end = edit.offset + edit.new_length;
+
+    Lexical lexer(new_source, engine);
+    lexer.setSymbolTable(symbols);
+    lexer.seek(restart);
+    TokenBuffer replacement(new_source);
+    size_t old_end = tokens.size();
+
+    while (true) {
+        Token token = lexer.nextToken();
+
+        // 编辑之后的Token若在旧序列中也有相同起点，其后的Token必然相同
+        if (token.getOffset() >= edit_end) {
+            size_t old_offset = token.getOffset() - edit.new_length + edit.old_length;
+            size_t match = findTokenStart(tokens, first, old_offset);
+            if (match < tokens.size()) {
+                old_end = match;
+                break;
+            }
+        }
+
+        replacement.push(token);
+        if (token.getType() == TokenType::EOF_TOKEN) {
+            break;
+        }
+    }
+
+    tokens.replaceRange(first, old_end, replacement, new_source, edit.offset, edit.old_length, edit.new_length);
+    return {first, old_end, first + replacement.size()};
+}
+
+} // namespace dreamlang::lexer
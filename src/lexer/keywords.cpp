@@ -0,0 +1,132 @@
+#include "lexer/keywords.h"
+#include <array>
+#include <cstdint>
+#include <utility>
+
+// 关键字的完美哈希
+//
+// 哈希值由首字节、末字节和长度组合而成：
+//     (first * first_mul + last * last_mul + length) % kTableSize
+// 乘数在编译期搜索得到，保证所有关键字落在不同的槽位上；查找时只需计算一次
+// 哈希并比较一次文本。修改关键字列表后表会自动重新生成，若找不到无冲突的
+// 乘数则编译失败。
+
+namespace dreamlang::lexer {
+
+namespace {
+
+struct KeywordEntry {
+    std::string_view text;
+    TokenType type;
+};
+
+constexpr std::array<KeywordEntry, 34> kKeywords = {{
+    {"bool", TokenType::KW_BOOL},
+    {"number", TokenType::KW_NUMBER},
+    {"char", TokenType::KW_CHAR},
+    {"string", TokenType::KW_STRING},
+    {"function", TokenType::KW_FUNCTION},
+    {"array", TokenType::KW_ARRAY},
+    {"class", TokenType::KW_CLASS},
+    {"object", TokenType::KW_OBJECT},
+    {"reference", TokenType::KW_REFERENCE},
+    {"package", TokenType::KW_PACKAGE},
+    {"import", TokenType::KW_IMPORT},
+    {"var", TokenType::KW_VAR},
+    {"val", TokenType::KW_VAL},
+    {"ref", TokenType::KW_REF},
+    {"return", TokenType::KW_RETURN},
+    {"fun", TokenType::KW_FUN},
+    {"if", TokenType::KW_IF},
+    {"else", TokenType::KW_ELSE},
+    {"for", TokenType::KW_FOR},
+    {"while", TokenType::KW_WHILE},
+    {"break", TokenType::KW_BREAK},
+    {"continue", TokenType::KW_CONTINUE},
+    {"switch", TokenType::KW_SWITCH},
+    {"case", TokenType::KW_CASE},
+    {"default", TokenType::KW_DEFAULT},
+    {"super", TokenType::KW_SUPER},
+    {"this", TokenType::KW_THIS},
+    {"available", TokenType::KW_AVAILABLE},
+    {"in", TokenType::KW_IN},
+    {"interface", TokenType::KW_INTERFACE},
+    {"abstract", TokenType::KW_ABSTRACT},
+    {"null", TokenType::NULL_LITERAL},
+    {"true", TokenType::BOOL_TRUE},
+    {"false", TokenType::BOOL_FALSE}
+}};
+
+constexpr size_t kTableSize = 128;
+
+struct HashParams {
+    uint32_t first_mul;
+    uint32_t last_mul;
+};
+
+constexpr size_t keywordHash(std::string_view text, HashParams params) {
+    return (static_cast<uint8_t>(text.front()) * params.first_mul +
+            static_cast<uint8_t>(text.back()) * params.last_mul + text.size()) % kTableSize;
+}
+
+constexpr bool isCollisionFree(HashParams params) {
+    bool used[kTableSize] = {};
+    for (const auto& keyword : kKeywords) {
+        size_t slot = keywordHash(keyword.text, params);
+        if (used[slot]) {
+            return false;
+        }
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr HashParams findHashParams() {
+    for (uint32_t first_mul = 1; first_mul < 64; ++first_mul) {
+        for (uint32_t last_mul = 1; last_mul < 64; ++last_mul) {
+            if (isCollisionFree({first_mul, last_mul})) {
+                return {first_mul, last_mul};
+            }
+        }
+    }
+    return {0, 0};
+}
+
+constexpr HashParams kHashParams = findHashParams();
+static_assert(kHashParams.first_mul != 0, "No collision-free keyword hash found; enlarge kTableSize");
+
+constexpr std::array<KeywordEntry, kTableSize> buildTable() {
+    std::array<KeywordEntry, kTableSize> table{};
+    for (auto& entry : table) {
+        entry = {std::string_view(), TokenType::IDENT};
+    }
+    for (const auto& keyword : kKeywords) {
+        table[keywordHash(keyword.text, kHashParams)] = keyword;
+    }
+    return table;
+}
+
+constexpr std::pair<size_t, size_t> keywordLengthRange() {
+    size_t min_length = kKeywords[0].text.size();
+    size_t max_length = min_length;
+    for (const auto& keyword : kKeywords) {
+        min_length = keyword.text.size() < min_length ? keyword.text.size() : min_length;
+        max_length = keyword.text.size() > max_length ? keyword.text.size() : max_length;
+    }
+    return {min_length, max_length};
+}
+
+constexpr std::array<KeywordEntry, kTableSize> kKeywordTable = buildTable();
+constexpr std::pair<size_t, size_t> kLengthRange = keywordLengthRange();
+
+} // namespace
+
+TokenType lookupKeyword(std::string_view text) {
+    if (text.size() < kLengthRange.first || text.size() > kLengthRange.second) {
+        return TokenType::IDENT;
+    }
+    const KeywordEntry& entry = kKeywordTable[keywordHash(text, kHashParams)];
+    return entry.text == text ? entry.type : TokenType::IDENT;
+}
+
+} // namespace dreamlang::lexer
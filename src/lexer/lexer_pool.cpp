@@ -0,0 +1,87 @@
+#include "lexer/lexer_pool.h"
+#include <algorithm>
+#include <thread>
+
+namespace dreamlang::lexer {
+
+LexerPool::Lease& LexerPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (entry_) {
+            pool_->release(std::move(entry_));
+        }
+        pool_ = other.pool_;
+        entry_ = std::move(other.entry_);
+    }
+    return *this;
+}
+
+LexerPool::Lease::~Lease() {
+    if (entry_) {
+        pool_->release(std::move(entry_));
+    }
+}
+
+const TokenBuffer& LexerPool::Lease::tokenize() {
+    entry_->tokens.reset(entry_->lexer.getSource());
+    entry_->lexer.tokenize(entry_->tokens);
+    return entry_->tokens;
+}
+
+LexerPool::LexerPool(LexerEngine engine, size_t max_idle)
+    : engine_(engine), max_idle_(max_idle != 0 ? max_idle : std::max(1u, std::thread::hardware_concurrency())) {
+    // 归还时只在预留的容量内追加，不会再分配
+    idle_.reserve(max_idle_);
+}
+
+LexerPool::Lease LexerPool::acquire(std::string_view source) {
+    std::unique_ptr<Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!idle_.empty()) {
+            entry = std::move(idle_.back());
+            idle_.pop_back();
+        }
+    }
+    if (!entry) {
+        entry = std::make_unique<Entry>(engine_);
+    }
+    entry->lexer.reset(source);
+    return {this, std::move(entry)};
+}
+
+void LexerPool::warm(size_t count) {
+    count = std::min(count, max_idle_);
+    while (idleCount() < count) {
+        auto entry = std::make_unique<Entry>(engine_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() >= count) {
+            break;
+        }
+        idle_.push_back(std::move(entry));
+    }
+}
+
+size_t LexerPool::idleCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return idle_.size();
+}
+
+void LexerPool::release(std::unique_ptr<Entry> entry) {
+    // 恢复默认设置，并且不再引用调用方的源码
+    Lexical& lexer = entry->lexer;
+    lexer.setEngine(engine_);
+    lexer.setErrorRecovery(false);
+    lexer.setSymbolTable(nullptr);
+    if (lexer.getMemoryResource() != std::pmr::get_default_resource()) {
+        lexer.setMemoryResource(std::pmr::get_default_resource());
+    }
+    lexer.reset(std::string_view());
+    entry->tokens.reset(std::string_view());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (idle_.size() < max_idle_) {
+        idle_.push_back(std::move(entry));
+    }
+}
+
+} // namespace dreamlang::lexer
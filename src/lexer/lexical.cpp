@@ -1,34 +1,92 @@
 #include "lexer/lexical.h"
+#include "lexer/keywords.h"
+#include "lexer/simd_scan.h"
+#include "lexer/symbol_table.h"
 #include "i18n/locale_manager.h"
+#include <algorithm>
 
 
 namespace dreamlang::lexer {
 
-// 静态成员初始化
-std::unordered_set<std::string> Lexical::keywords_;
-bool Lexical::initialized_ = false;
+namespace {
 
-Lexical::Lexical(std::string source_code)
-    : source_code_(std::move(source_code)), index_(0), line_(1), column_(1) {
-    if (!initialized_) {
-        initializeStatic();
-        initialized_ = true;
+// 估计Token数量时假定的平均每个Token的源码字节数（典型源码约为 4）
+constexpr size_t kBytesPerTokenEstimate = 4;
+
+// 每次向前批量验证UTF-8的字节数
+constexpr size_t kUtf8Window = 64 * 1024;
+
+} // namespace
+
+bool parseLexerEngine(const std::string& name, LexerEngine& engine) {
+    if (name == "classic") {
+        engine = LexerEngine::CLASSIC;
+        return true;
+    }
+    if (name == "table") {
+        engine = LexerEngine::TABLE;
+        return true;
     }
+    return false;
+}
+
+template <typename Policy>
+BasicLexical<Policy>::BasicLexical(std::string source_code, LexerEngine engine)
+    : owned_source_(std::move(source_code)), source_(owned_source_), trivia_(source_), tokens_emitted_(0), index_(0),
+      token_start_(0), engine_(engine),
+      error_recovery_(false), symbols_(nullptr), utf8_checked_(0) {
+}
+
+template <typename Policy>
+BasicLexical<Policy>::BasicLexical(const char* source_code, LexerEngine engine)
+    : BasicLexical(std::string(source_code), engine) {
 }
 
-void Lexical::initializeStatic() {
-    keywords_ = {
-        "bool", "number", "char", "string", "function", "array", "class", "object",
-        "reference", "package", "import", "var", "val", "ref", "return", "fun",
-        "if", "else", "for", "while", "break", "continue", "switch", "case",
-        "default", "super", "this", "available", "in", "interface", "abstract",
-        "null", "true", "false"
-    };
+template <typename Policy>
+BasicLexical<Policy>::BasicLexical(std::string_view source_view, LexerEngine engine)
+    : source_(source_view), trivia_(source_), tokens_emitted_(0), index_(0), token_start_(0), engine_(engine),
+      error_recovery_(false), symbols_(nullptr), utf8_checked_(0) {
 }
 
-Token Lexical::nextToken() {
+template <typename Policy>
+Token BasicLexical<Policy>::nextToken() {
+    Token token = engine_ == LexerEngine::TABLE ? nextTokenTable() : nextTokenClassic();
+    if (index_ > utf8_checked_) {
+        checkUtf8();
+    }
+    if constexpr (Policy::kRetainTrivia) {
+        ++tokens_emitted_;
+    }
+    return token;
+}
+
+template <typename Policy>
+void BasicLexical<Policy>::checkUtf8() {
+    const char* data = source_.data();
+    while (utf8_checked_ < index_) {
+        // 窗口终点退回到字符起点，使窗口内的验证结果与整体验证一致
+        size_t end = std::min(std::max(index_, utf8_checked_ + kUtf8Window), source_.size());
+        for (int i = 0; i < 3 && end < source_.size() && (static_cast<unsigned char>(data[end]) & 0xC0) == 0x80;
+             ++i) {
+            --end;
+        }
+
+        size_t invalid = simd::validateUtf8(data, utf8_checked_, end);
+        if (invalid == end || invalid >= index_) {
+            // 窗口全部合法，或非法序列还在前面（等分析越过它时再报告）
+            utf8_checked_ = invalid;
+            continue;
+        }
+        reportErrorAt(invalid, _("Invalid UTF-8 sequence"), '\0', "UTF8");
+        utf8_checked_ = nextCharBoundary(invalid);
+    }
+}
+
+template <typename Policy>
+Token BasicLexical<Policy>::nextTokenClassic() {
     while (true) {
         skipWhitespace();
+        token_start_ = index_;
 
         if (isAtEnd()) {
             return makeToken(TokenType::EOF_TOKEN);
@@ -39,6 +97,16 @@ Token Lexical::nextToken() {
         // 处理换行符
         if (c == '\n') {
             advance();
+            if constexpr (!Policy::kEmitTrivia) {
+                if constexpr (Policy::kRetainTrivia) {
+                    recordTrivia(TriviaKind::NEWLINE, token_start_);
+                }
+                // 与产生换行Token时一样在此验证UTF-8，错误的报告顺序不受策略影响
+                if (index_ > utf8_checked_) {
+                    checkUtf8();
+                }
+                continue;
+            }
             return makeToken(TokenType::LINEBREAK, "\n");
         }
 
@@ -49,7 +117,9 @@ Token Lexical::nextToken() {
         }
 
         if (c == '/' && peekChar() == '*') {
-            skipMultiLineComment();
+            if (!skipMultiLineComment()) {
+                return errorToken(_("Unterminated comment"), '*', "MULTI_COMMENT", index_);
+            }
             continue; // 继续循环而不是递归调用
         }
 
@@ -113,8 +183,7 @@ Token Lexical::nextToken() {
                     advance();
                     return makeToken(TokenType::LOGICAL_AND, "&&");
                 }
-                throwError(_("Invalid character"), c, "UNKNOWN");
-                break;
+                return errorToken(_("Invalid character"), c, "UNKNOWN", index_);
 
             case '|':
                 advance();
@@ -122,8 +191,7 @@ Token Lexical::nextToken() {
                     advance();
                     return makeToken(TokenType::LOGICAL_OR, "||");
                 }
-                throwError(_("Invalid character"), c, "UNKNOWN");
-                break;
+                return errorToken(_("Invalid character"), c, "UNKNOWN", index_);
 
             case '+':
                 advance();
@@ -190,135 +258,200 @@ Token Lexical::nextToken() {
                 return makeToken(TokenType::RIGHT_BRACE, "}");
 
             default:
-                throwError(_("Unexpected character"), c, "UNKNOWN");
+                return errorToken(_("Unexpected character"), c, "UNKNOWN", nextCharBoundary(index_));
         }
     }
 }
 
-std::vector<Token> Lexical::tokenize() {
-    std::vector<Token> tokens;
+template <typename Policy>
+TokenBuffer BasicLexical<Policy>::tokenize() {
+    TokenBuffer tokens(source_, decoded_.upstream());
+    tokenize(tokens);
+    return tokens;
+}
+
+template <typename Policy>
+void BasicLexical<Policy>::tokenize(TokenBuffer& tokens) {
+    // 按源码长度预留，避免逐步扩容的重复分配与拷贝
+    tokens.reserve(tokens.size() + (source_.size() - index_) / kBytesPerTokenEstimate + 1);
     
     while (!isAtEnd()) {
         Token token = nextToken();
         if (token.getType() != TokenType::EOF_TOKEN) {
-            tokens.push_back(token);
+            tokens.push(token);
         } else {
             break;
         }
     }
     
-    tokens.push_back(makeToken(TokenType::EOF_TOKEN));
-    return tokens;
+    tokens.push(TokenType::EOF_TOKEN, index_, 0, {});
+}
+
+template <typename Policy>
+void BasicLexical<Policy>::setMemoryResource(std::pmr::memory_resource* resource) {
+    decoded_ = util::Arena(util::Arena::kDefaultBlockSize, resource);
+    trivia_ = TriviaTable(source_, resource);
 }
 
-void Lexical::reset() {
+template <typename Policy>
+void BasicLexical<Policy>::reset() {
     index_ = 0;
-    line_ = 1;
-    column_ = 1;
+    token_start_ = 0;
+    utf8_checked_ = 0;
+    diagnostics_.clear();
+    trivia_.clear();
+    tokens_emitted_ = 0;
 }
 
-char Lexical::currentChar() const {
+template <typename Policy>
+void BasicLexical<Policy>::reset(std::string_view new_source) {
+    // 不再持有自己的源码，但保留其容量
+    owned_source_.clear();
+    source_ = new_source;
+    file_start_ = SourceLocation();
+    decoded_.reset();
+    trivia_.reset(source_);
+    line_index_.reset();
+    reset();
+}
+
+template <typename Policy>
+void BasicLexical<Policy>::seek(size_t offset) {
+    index_ = std::min(offset, source_.size());
+    token_start_ = index_;
+    utf8_checked_ = index_;
+}
+
+template <typename Policy>
+int BasicLexical<Policy>::getCurrentLine() const {
+    return getLineIndex().lineOf(index_);
+}
+
+template <typename Policy>
+int BasicLexical<Policy>::getCurrentColumn() const {
+    return getLineIndex().resolve(index_).column;
+}
+
+template <typename Policy>
+const LineIndex& BasicLexical<Policy>::getLineIndex() const {
+    if (!line_index_) {
+        line_index_.emplace(source_);
+    }
+    return *line_index_;
+}
+
+template <typename Policy>
+char BasicLexical<Policy>::currentChar() const {
     if (isAtEnd()) {
         return '\0';
     }
-    return source_code_[index_];
+    return source_[index_];
 }
 
-char Lexical::peekChar(size_t offset) const {
+template <typename Policy>
+char BasicLexical<Policy>::peekChar(size_t offset) const {
     size_t peek_index = index_ + offset;
-    if (peek_index >= source_code_.length()) {
+    if (peek_index >= source_.size()) {
         return '\0';
     }
-    return source_code_[peek_index];
+    return source_[peek_index];
 }
 
-void Lexical::advance() {
+template <typename Policy>
+void BasicLexical<Policy>::advance() {
     if (!isAtEnd()) {
-        if (source_code_[index_] == '\n') {
-            line_++;
-            column_ = 1;
-        } else {
-            column_++;
-        }
         index_++;
     }
 }
-void Lexical::skipWhitespace() {
-    while (!isAtEnd()) {
-        char c = currentChar();
-        if (c == ' ' || c == '\r' || c == '\t') {
-            advance();
-        } else {
-            break;
+
+template <typename Policy>
+void BasicLexical<Policy>::skipWhitespace() {
+    size_t start = index_;
+    advanceBy(simd::skipBlanks(source_.data(), index_, source_.size()) - index_);
+    if constexpr (Policy::kRetainTrivia) {
+        if (index_ > start) {
+            recordTrivia(TriviaKind::WHITESPACE, start);
         }
     }
 }
 
-void Lexical::skipSingleLineComment() {
-    // 跳过 //
-    advance();
-    advance();
-    
-    while (!isAtEnd() && currentChar() != '\n') {
-        advance();
+template <typename Policy>
+void BasicLexical<Policy>::skipSingleLineComment() {
+    // 跳过 // 及其后直到换行符之前的内容（不含换行符）
+    size_t start = index_;
+    advanceBy(simd::findByte(source_.data(), index_ + 2, source_.size(), '\n') - index_);
+    if constexpr (Policy::kRetainTrivia) {
+        recordTrivia(TriviaKind::LINE_COMMENT, start);
     }
 }
 
-void Lexical::skipMultiLineComment() {
-    // 跳过 /*
-    advance();
-    advance();
+template <typename Policy>
+bool BasicLexical<Policy>::skipMultiLineComment() {
+    const char* data = source_.data();
+    const size_t size = source_.size();
     
-    while (!isAtEnd()) {
-        if (currentChar() == '*' && peekChar() == '/') {
-            advance(); // 跳过 *
-            advance(); // 跳过 /
+    // 跳过 /*，然后逐个定位 '*' 并检查其后是否为 '/'
+    size_t pos = index_ + 2;
+    bool closed = false;
+    while (true) {
+        pos = simd::findByte(data, pos, size, '*');
+        if (pos + 1 >= size) {
+            pos = size;
             break;
         }
-        advance();
+        if (data[pos + 1] == '/') {
+            pos += 2; // 跳过 */
+            closed = true;
+            break;
+        }
+        ++pos;
     }
-    
-    if (isAtEnd()) {
-        throwError(_("Unterminated comment"), '*', "MULTI_COMMENT");
+    size_t start = index_;
+    advanceTo(pos);
+    if constexpr (Policy::kRetainTrivia) {
+        if (closed) {
+            recordTrivia(TriviaKind::BLOCK_COMMENT, start);
+        }
     }
+    
+    // 注释恰好在文件末尾闭合（源码不再被补上结尾换行）时不是错误
+    return closed;
 }
 
-Token Lexical::readIdentifierOrKeyword() {
+template <typename Policy>
+Token BasicLexical<Policy>::readIdentifierOrKeyword() {
     size_t start = index_;
     
     while (!isAtEnd() && isAlphaNumeric(currentChar())) {
         advance();
     }
     
-    std::string text = source_code_.substr(start, index_ - start);
-    
-    // 检查特殊字面量
-    if (text == "null") {
-        return makeToken(TokenType::NULL_LITERAL, text);
-    } else if (text == "true") {
-        return makeToken(TokenType::BOOL_TRUE, text);
-    } else if (text == "false") {
-        return makeToken(TokenType::BOOL_FALSE, text);
-    } else if (isKeyword(text)) {
-        return makeToken(TokenType::KEYWORD, text);
-    } else {
-        return makeToken(TokenType::IDENT, text);
-    }
+    return makeWordToken(sourceSlice(start));
 }
 
-Token Lexical::readNumber() {
-    size_t start = index_;
-    
-    while (!isAtEnd() && isDigit(currentChar())) {
-        advance();
+template <typename Policy>
+Token BasicLexical<Policy>::readNumber() {
+    // 十六进制（0x）与二进制（0b）整数，前缀之后至少要有一位数字
+    if (currentChar() == '0') {
+        char prefix = peekChar();
+        bool hex = prefix == 'x' || prefix == 'X';
+        if (hex || prefix == 'b' || prefix == 'B') {
+            bool (*digit)(char) = hex ? isHexDigit : isBinaryDigit;
+            advanceBy(2);
+            if (isAtEnd() || !digit(currentChar())) {
+                return errorToken(_("Invalid number format"), currentChar(), "NUMBER", index_);
+            }
+            skipDigits(digit);
+            return makeNumberToken();
+        }
     }
     
+    skipDigits(isDigit);
+    
     // 处理小数点
     if (!isAtEnd() && currentChar() == '.' && isDigit(peekChar())) {
         advance(); // 跳过小数点
-        while (!isAtEnd() && isDigit(currentChar())) {
-            advance();
-        }
+        skipDigits(isDigit);
     }
     
     // 处理科学计数法
@@ -328,68 +461,130 @@ Token Lexical::readNumber() {
             advance();
         }
         if (isAtEnd() || !isDigit(currentChar())) {
-            throwError(_("Invalid number format"), currentChar(), "NUMBER");
-        }
-        while (!isAtEnd() && isDigit(currentChar())) {
-            advance();
+            return errorToken(_("Invalid number format"), currentChar(), "NUMBER", index_);
         }
+        skipDigits(isDigit);
     }
     
-    std::string text = source_code_.substr(start, index_ - start);
-    return makeToken(TokenType::NUMBER, text);
+    return makeNumberToken();
+}
+
+template <typename Policy>
+void BasicLexical<Policy>::skipDigits(bool (*digit)(char)) {
+    // 分隔符 '_' 只有后面紧跟数字时才属于数字，因此不会出现在开头、结尾或连续出现
+    while (!isAtEnd() && (digit(currentChar()) || (currentChar() == '_' && digit(peekChar())))) {
+        advance();
+    }
 }
 
-Token Lexical::readString() {
+template <typename Policy>
+Token BasicLexical<Policy>::readString() {
     advance(); // 跳过开始的双引号
     
-    std::string value;
+    const char* data = source_.data();
+    const size_t size = source_.size();
+    size_t start = index_;
     
-    while (!isAtEnd() && currentChar() != '"') {
-        if (currentChar() == '\\') {
-            advance();
-            char escaped = processEscapeSequence();
-            value += escaped;
-        } else {
-            value += currentChar();
-            advance();
+    if constexpr (!Policy::kMaterializeValues) {
+        // 不产生值：只检查转义序列，不解码
+        while (!isAtEnd() && currentChar() != '"') {
+            if (currentChar() == '\\') {
+                advance();
+                processEscapeSequence();
+            } else {
+                advanceTo(simd::findEitherByte(data, index_, size, '"', '\\'));
+            }
+        }
+        if (isAtEnd()) {
+            return errorToken(_("Unterminated string"), '"', "STRING", simd::findByte(data, token_start_, size, '\n'));
         }
+        advance(); // 跳过结束的双引号
+        return makeToken(TokenType::STRING);
+    }
+    
+    // 快速路径：没有转义时直接引用源码
+    advanceTo(simd::findEitherByte(data, index_, size, '"', '\\'));
+    
+    if (!isAtEnd() && currentChar() == '\\') {
+        // 遇到转义：解码结果不会比源码片段长，先找到结束引号，按片段长度在竞技场中
+        // 分配一次，解码后再归还多余的尾部
+        size_t end = index_;
+        while ((end = simd::findEitherByte(data, end, size, '"', '\\')) < size && data[end] == '\\') {
+            end += 2;
+        }
+        size_t capacity = std::min(end, size) - start;
+        char* buffer = decoded_.allocate(capacity);
+        char* out = std::copy(data + start, data + index_, buffer);
+        
+        // 转义之间的片段整段复制
+        while (!isAtEnd() && currentChar() != '"') {
+            if (currentChar() == '\\') {
+                advance();
+                *out++ = processEscapeSequence();
+            } else {
+                size_t run_end = simd::findEitherByte(data, index_, size, '"', '\\');
+                out = std::copy(data + index_, data + run_end, out);
+                advanceTo(run_end);
+            }
+        }
+        
+        if (isAtEnd()) {
+            decoded_.shrink(buffer, capacity, 0);
+            return errorToken(_("Unterminated string"), '"', "STRING",
+                              simd::findByte(data, token_start_, size, '\n'));
+        }
+        
+        size_t length = out - buffer;
+        decoded_.shrink(buffer, capacity, length);
+        advance(); // 跳过结束的双引号
+        return makeToken(TokenType::STRING, std::string_view(buffer, length));
     }
     
     if (isAtEnd()) {
-        throwError(_("Unterminated string"), '"', "STRING");
+        // 恢复时只放弃字符串起点所在的这一行
+        return errorToken(_("Unterminated string"), '"', "STRING", simd::findByte(data, token_start_, size, '\n'));
     }
     
+    std::string_view value = sourceSlice(start);
     advance(); // 跳过结束的双引号
     return makeToken(TokenType::STRING, value);
 }
 
-Token Lexical::readChar() {
+template <typename Policy>
+Token BasicLexical<Policy>::readChar() {
     advance(); // 跳过开始的单引号
     
     if (isAtEnd()) {
-        throwError(_("Unterminated character literal"), '\'', "CHAR");
+        return errorToken(_("Unterminated character literal"), '\'', "CHAR", index_);
     }
     
-    char value;
+    std::string_view value;
     if (currentChar() == '\\') {
         advance();
-        value = processEscapeSequence();
+        char decoded = processEscapeSequence();
+        if constexpr (Policy::kMaterializeValues) {
+            value = decoded_.copy(std::string_view(&decoded, 1));
+        }
     } else {
-        value = currentChar();
+        size_t start = index_;
         advance();
+        value = sourceSlice(start);
     }
     
     if (isAtEnd() || currentChar() != '\'') {
-        throwError(_("Unterminated character literal"), '\'', "CHAR");
+        return errorToken(_("Unterminated character literal"), '\'', "CHAR", index_);
     }
     
     advance(); // 跳过结束的单引号
-    return makeToken(TokenType::CHAR, std::string(1, value));
+    return makeToken(TokenType::CHAR, value);
 }
 
-char Lexical::processEscapeSequence() {
+template <typename Policy>
+char BasicLexical<Policy>::processEscapeSequence() {
     if (isAtEnd()) {
-        throwError(_("Invalid escape sequence"), '\\', "ESCAPE");
+        // 恢复模式下由调用方随后报告未闭合的字面量
+        reportError(_("Invalid escape sequence"), '\\', "ESCAPE");
+        return '\\';
     }
     
     char c = currentChar();
@@ -406,38 +601,114 @@ char Lexical::processEscapeSequence() {
         case '"': return '"';
         case '0': return '\0';
         default:
-            throwError(_("Invalid escape sequence"), c, "ESCAPE");
+            // 恢复模式下按字面保留该字符
+            reportError(_("Invalid escape sequence"), c, "ESCAPE");
             return c;
     }
 }
 
-bool Lexical::isDigit(char c) {
+template <typename Policy>
+bool BasicLexical<Policy>::isDigit(char c) {
     return c >= '0' && c <= '9';
 }
 
-bool Lexical::isHexDigit(char c) {
+template <typename Policy>
+bool BasicLexical<Policy>::isHexDigit(char c) {
     return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
 }
 
-bool Lexical::isAlpha(char c) {
-    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+template <typename Policy>
+bool BasicLexical<Policy>::isBinaryDigit(char c) {
+    return c == '0' || c == '1';
+}
+
+template <typename Policy>
+bool BasicLexical<Policy>::isAlpha(char c) {
+    // 非ASCII字节只可能属于多字节UTF-8字符，合法性已由 checkUtf8() 统一验证
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || static_cast<unsigned char>(c) >= 0x80;
 }
 
-bool Lexical::isAlphaNumeric(char c) {
+template <typename Policy>
+bool BasicLexical<Policy>::isAlphaNumeric(char c) {
     return isAlpha(c) || isDigit(c);
 }
 
-bool Lexical::isKeyword(const std::string& text) {
-    return keywords_.find(text) != keywords_.end();
+template <typename Policy>
+Token BasicLexical<Policy>::makeToken(TokenType type, std::string_view value) const {
+    if constexpr (!Policy::kMaterializeValues) {
+        value = {};
+    }
+    return {type, value, tokenOffset(), tokenLength()};
+}
+
+template <typename Policy>
+Token BasicLexical<Policy>::makeNumberToken() const {
+    if constexpr (!Policy::kMaterializeValues) {
+        return makeToken(TokenType::NUMBER);
+    }
+    std::string_view text = sourceSlice(token_start_);
+    NumberLiteral number = parseNumberLiteral(text);
+    return {TokenType::NUMBER, text, tokenOffset(), tokenLength(), number.payload(), number.flags()};
+}
+
+template <typename Policy>
+Token BasicLexical<Policy>::makeWordToken(std::string_view text) const {
+    TokenType type = lookupKeyword(text);
+    if (type != TokenType::IDENT) {
+        return makeToken(type, text);
+    }
+    SymbolId symbol = symbols_ != nullptr ? symbols_->intern(text) : SymbolTable::kInvalidSymbol;
+    if constexpr (!Policy::kMaterializeValues) {
+        // 不产生值时仍然驻留，符号表的内容与策略无关
+        return makeToken(type, text);
+    }
+    return {TokenType::IDENT, text, tokenOffset(), tokenLength(), symbol};
+}
+
+template <typename Policy>
+std::string_view BasicLexical<Policy>::sourceSlice(size_t start) const {
+    return source_.substr(start, index_ - start);
 }
 
-Token Lexical::makeToken(TokenType type, const std::string& value) const {
-    return {type, value, line_, column_};
+template <typename Policy>
+void BasicLexical<Policy>::throwError(size_t offset, const std::string& error_type, char error_char,
+                                           const std::string& token_type) const {
+    SourcePosition position = getLineIndex().resolve(offset);
+    throw LexicalException(error_type, error_char, token_type, position.line, position.column, getLocation(offset));
 }
 
-void Lexical::throwError(const std::string& error_type, char error_char, 
-                        const std::string& token_type) const {
-    throw LexicalException(error_type, error_char, token_type, line_, column_);
+template <typename Policy>
+void BasicLexical<Policy>::reportErrorAt(size_t offset, const std::string& error_type, char error_char,
+                                         const std::string& token_type) {
+    if (!getErrorRecovery()) {
+        throwError(offset, error_type, error_char, token_type);
+    }
+    diagnostics_.push_back({error_type, token_type, static_cast<uint32_t>(offset),
+                            static_cast<uint32_t>(token_start_), error_char, getLocation(offset)});
+}
+
+template <typename Policy>
+Token BasicLexical<Policy>::errorToken(const std::string& error_type, char error_char,
+                                       const std::string& token_type, size_t resume) {
+    reportError(error_type, error_char, token_type);
+    // 至少前进一个字节，保证分析能继续推进
+    advanceTo(std::max(resume, token_start_ + 1));
+    return makeToken(TokenType::ERROR, sourceSlice(token_start_));
 }
 
+template <typename Policy>
+size_t BasicLexical<Policy>::nextCharBoundary(size_t position) const {
+    ++position;
+    while (position < source_.size() && (static_cast<unsigned char>(source_[position]) & 0xC0) == 0x80) {
+        ++position;
+    }
+    return position;
+}
+
+// 其余成员（表驱动引擎）在 lexical_table.cpp 中实例化
+template class BasicLexical<DefaultLexPolicy>;
+template class BasicLexical<CountingLexPolicy>;
+template class BasicLexical<StatisticsLexPolicy>;
+template class BasicLexical<TriviaLexPolicy>;
+
 } // namespace dreamlang::lexer
@@ -8,13 +8,15 @@ LexicalException::LexicalException(const std::string& error_type,
                                  char error_char,
                                  const std::string& error_token_type,
                                  int line,
-                                 int column)
-    : std::runtime_error(generateMessage()),
+                                 int column,
+                                 SourceLocation location)
+    : std::runtime_error(generateMessage(error_type, error_char, error_token_type, line, column)),
       error_type_(error_type),
       error_char_(error_char),
       error_token_type_(error_token_type),
       line_(line),
-      column_(column) {
+      column_(column),
+      location_(location) {
 }
 
 LexicalException::LexicalException(const std::string& message, int line, int column)
@@ -26,21 +28,25 @@ LexicalException::LexicalException(const std::string& message, int line, int col
       column_(column) {
 }
 
-std::string LexicalException::generateMessage() const {
+std::string LexicalException::generateMessage(const std::string& error_type,
+                                              char error_char,
+                                              const std::string& error_token_type,
+                                              int line,
+                                              int column) {
     std::ostringstream oss;
     
-    if (column_ >= 0) {
-        oss << error_type_ << " at line " << line_ << ", column " << column_;
+    if (column >= 0) {
+        oss << error_type << " at line " << line << ", column " << column;
     } else {
-        oss << error_type_ << " at line " << line_;
+        oss << error_type << " at line " << line;
     }
     
-    if (error_char_ != '\0') {
-        oss << ": unexpected character '" << error_char_ << "'";
+    if (error_char != '\0') {
+        oss << ": unexpected character '" << error_char << "'";
     }
     
-    if (!error_token_type_.empty()) {
-        oss << " (token type: " << error_token_type_ << ")";
+    if (!error_token_type.empty()) {
+        oss << " (token type: " << error_token_type << ")";
     }
     
     return oss.str();
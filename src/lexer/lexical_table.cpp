@@ -0,0 +1,485 @@
+#include "lexer/lexical.h"
+#include "lexer/keywords.h"
+#include "i18n/locale_manager.h"
+#include <array>
+
+// 表驱动词法分析引擎
+//
+// 每个字节先通过 256 项的字符分类表映射到字符类，再由 (状态, 字符类) 转移表
+// 推进DFA，直到无法继续转移为止。标识符、数字、操作符、空白完全由表驱动；
+// 字符串、字符和注释在DFA识别出起始符后交给与传统引擎共享的读取函数处理。
+// 输出的Token流（包括错误及其位置）与传统引擎完全一致。
+
+namespace dreamlang::lexer {
+
+namespace {
+
+// 字符类
+enum CharClass : uint8_t {
+    CC_OTHER,
+    CC_SPACE,
+    CC_NEWLINE,
+    CC_ALPHA,
+    // '_'：标识符字符，也是数字分隔符
+    CC_UNDERSCORE,
+    // 'e' 'E'：指数标记，也是十六进制数字
+    CC_EXP,
+    // 'b' 'B'：二进制前缀，也是十六进制数字
+    CC_BIN_MARK,
+    // 'x' 'X'：十六进制前缀
+    CC_HEX_MARK,
+    // 其余的十六进制字母
+    CC_HEX_ALPHA,
+    CC_ZERO,
+    CC_ONE,
+    CC_DIGIT,
+    CC_DOT,
+    CC_DQUOTE,
+    CC_SQUOTE,
+    CC_EQUAL,
+    CC_BANG,
+    CC_LESS,
+    CC_GREATER,
+    CC_AMP,
+    CC_PIPE,
+    CC_PLUS,
+    CC_MINUS,
+    CC_STAR,
+    CC_SLASH,
+    CC_PERCENT,
+    CC_COMMA,
+    CC_COLON,
+    CC_SEMICOLON,
+    CC_LPAREN,
+    CC_RPAREN,
+    CC_LBRACKET,
+    CC_RBRACKET,
+    CC_LBRACE,
+    CC_RBRACE,
+    CC_END,
+    CC_COUNT
+};
+
+// DFA状态
+enum State : uint8_t {
+    S_START,
+    S_SPACE,
+    S_NEWLINE,
+    S_IDENT,
+    S_ZERO,
+    S_INT,
+    S_INT_SEP,
+    S_DOT_PENDING,
+    S_FRACTION,
+    S_FRACTION_SEP,
+    S_EXP_MARK,
+    S_EXP_SIGN,
+    S_EXP_DIGITS,
+    S_EXP_SEP,
+    S_HEX_PREFIX,
+    S_HEX,
+    S_HEX_SEP,
+    S_BIN_PREFIX,
+    S_BIN,
+    S_BIN_SEP,
+    S_ASSIGN,
+    S_EQUAL,
+    S_BANG,
+    S_NOT_EQUAL,
+    S_LESS,
+    S_LESS_EQUAL,
+    S_GREATER,
+    S_GREATER_EQUAL,
+    S_AMP,
+    S_AND,
+    S_PIPE,
+    S_OR,
+    S_STAR,
+    S_POWER,
+    S_SLASH,
+    S_LINE_COMMENT,
+    S_BLOCK_COMMENT,
+    S_STRING,
+    S_CHAR,
+    S_PLUS,
+    S_MINUS,
+    S_PERCENT,
+    S_DOT,
+    S_COMMA,
+    S_COLON,
+    S_SEMICOLON,
+    S_LPAREN,
+    S_RPAREN,
+    S_LBRACKET,
+    S_RBRACKET,
+    S_LBRACE,
+    S_RBRACE,
+    S_COUNT,
+    S_DEAD = 0xFF
+};
+
+// DFA停止时对所在状态采取的动作
+enum Action : uint8_t {
+    // 非接受状态：回退到最近的接受状态
+    A_BACKTRACK,
+    // 产生Token
+    A_TOKEN,
+    // 跳过（空白）
+    A_SKIP,
+    A_STRING,
+    A_CHAR,
+    A_LINE_COMMENT,
+    A_BLOCK_COMMENT,
+    // 指数部分或进制前缀之后缺少数字
+    A_BAD_NUMBER,
+    // 单独的 '&' 或 '|'
+    A_BAD_OPERATOR,
+    // 无法识别的起始字符
+    A_UNEXPECTED
+};
+
+using CharClassTable = std::array<uint8_t, 256>;
+using TransitionTable = std::array<std::array<uint8_t, CC_COUNT>, S_COUNT>;
+
+struct StateInfo {
+    Action action;
+    TokenType type;
+};
+
+constexpr CharClassTable buildCharClasses() {
+    CharClassTable table{};
+    for (int c = 'a'; c <= 'z'; ++c) {
+        table[c] = c <= 'f' ? CC_HEX_ALPHA : CC_ALPHA;
+    }
+    for (int c = 'A'; c <= 'Z'; ++c) {
+        table[c] = c <= 'F' ? CC_HEX_ALPHA : CC_ALPHA;
+    }
+    // 非ASCII字节组成UTF-8字符，与字母一样用作标识符字符（合法性另行验证）
+    for (int c = 0x80; c <= 0xFF; ++c) {
+        table[c] = CC_ALPHA;
+    }
+    for (int c = '2'; c <= '9'; ++c) {
+        table[c] = CC_DIGIT;
+    }
+    table['0'] = CC_ZERO;
+    table['1'] = CC_ONE;
+    table['_'] = CC_UNDERSCORE;
+    table['e'] = CC_EXP;
+    table['E'] = CC_EXP;
+    table['b'] = CC_BIN_MARK;
+    table['B'] = CC_BIN_MARK;
+    table['x'] = CC_HEX_MARK;
+    table['X'] = CC_HEX_MARK;
+    table[' '] = CC_SPACE;
+    table['\t'] = CC_SPACE;
+    table['\r'] = CC_SPACE;
+    table['\n'] = CC_NEWLINE;
+    table['.'] = CC_DOT;
+    table['"'] = CC_DQUOTE;
+    table['\''] = CC_SQUOTE;
+    table['='] = CC_EQUAL;
+    table['!'] = CC_BANG;
+    table['<'] = CC_LESS;
+    table['>'] = CC_GREATER;
+    table['&'] = CC_AMP;
+    table['|'] = CC_PIPE;
+    table['+'] = CC_PLUS;
+    table['-'] = CC_MINUS;
+    table['*'] = CC_STAR;
+    table['/'] = CC_SLASH;
+    table['%'] = CC_PERCENT;
+    table[','] = CC_COMMA;
+    table[':'] = CC_COLON;
+    table[';'] = CC_SEMICOLON;
+    table['('] = CC_LPAREN;
+    table[')'] = CC_RPAREN;
+    table['['] = CC_LBRACKET;
+    table[']'] = CC_RBRACKET;
+    table['{'] = CC_LBRACE;
+    table['}'] = CC_RBRACE;
+    return table;
+}
+
+constexpr TransitionTable buildTransitions() {
+    TransitionTable table{};
+    for (auto& row : table) {
+        for (auto& next : row) {
+            next = S_DEAD;
+        }
+    }
+
+    // 各类数字字符
+    constexpr uint8_t kDecimalDigits[] = {CC_ZERO, CC_ONE, CC_DIGIT};
+    constexpr uint8_t kBinaryDigits[] = {CC_ZERO, CC_ONE};
+    constexpr uint8_t kHexDigits[] = {CC_ZERO, CC_ONE, CC_DIGIT, CC_EXP, CC_BIN_MARK, CC_HEX_ALPHA};
+    constexpr uint8_t kIdentChars[] = {CC_ALPHA, CC_UNDERSCORE, CC_EXP, CC_BIN_MARK, CC_HEX_MARK, CC_HEX_ALPHA,
+                                       CC_ZERO, CC_ONE, CC_DIGIT};
+
+    // 起始状态
+    auto& start = table[S_START];
+    start[CC_SPACE] = S_SPACE;
+    start[CC_NEWLINE] = S_NEWLINE;
+    for (uint8_t char_class : kIdentChars) {
+        start[char_class] = S_IDENT;
+    }
+    start[CC_ZERO] = S_ZERO;
+    start[CC_ONE] = S_INT;
+    start[CC_DIGIT] = S_INT;
+    start[CC_DQUOTE] = S_STRING;
+    start[CC_SQUOTE] = S_CHAR;
+    start[CC_EQUAL] = S_ASSIGN;
+    start[CC_BANG] = S_BANG;
+    start[CC_LESS] = S_LESS;
+    start[CC_GREATER] = S_GREATER;
+    start[CC_AMP] = S_AMP;
+    start[CC_PIPE] = S_PIPE;
+    start[CC_STAR] = S_STAR;
+    start[CC_SLASH] = S_SLASH;
+    start[CC_PLUS] = S_PLUS;
+    start[CC_MINUS] = S_MINUS;
+    start[CC_PERCENT] = S_PERCENT;
+    start[CC_DOT] = S_DOT;
+    start[CC_COMMA] = S_COMMA;
+    start[CC_COLON] = S_COLON;
+    start[CC_SEMICOLON] = S_SEMICOLON;
+    start[CC_LPAREN] = S_LPAREN;
+    start[CC_RPAREN] = S_RPAREN;
+    start[CC_LBRACKET] = S_LBRACKET;
+    start[CC_RBRACKET] = S_RBRACKET;
+    start[CC_LBRACE] = S_LBRACE;
+    start[CC_RBRACE] = S_RBRACE;
+
+    table[S_SPACE][CC_SPACE] = S_SPACE;
+
+    // 标识符
+    for (uint8_t char_class : kIdentChars) {
+        table[S_IDENT][char_class] = S_IDENT;
+    }
+
+    // 十进制数字：整数部分、小数部分、指数部分，每一段中 '_' 之后必须紧跟数字（*_SEP 状态不接受）
+    for (uint8_t char_class : kDecimalDigits) {
+        table[S_ZERO][char_class] = S_INT;
+        table[S_INT][char_class] = S_INT;
+        table[S_INT_SEP][char_class] = S_INT;
+        table[S_DOT_PENDING][char_class] = S_FRACTION;
+        table[S_FRACTION][char_class] = S_FRACTION;
+        table[S_FRACTION_SEP][char_class] = S_FRACTION;
+        table[S_EXP_MARK][char_class] = S_EXP_DIGITS;
+        table[S_EXP_SIGN][char_class] = S_EXP_DIGITS;
+        table[S_EXP_DIGITS][char_class] = S_EXP_DIGITS;
+        table[S_EXP_SEP][char_class] = S_EXP_DIGITS;
+    }
+    for (uint8_t state : {S_ZERO, S_INT}) {
+        table[state][CC_UNDERSCORE] = S_INT_SEP;
+        table[state][CC_DOT] = S_DOT_PENDING;
+        table[state][CC_EXP] = S_EXP_MARK;
+    }
+    table[S_FRACTION][CC_UNDERSCORE] = S_FRACTION_SEP;
+    table[S_FRACTION][CC_EXP] = S_EXP_MARK;
+    table[S_EXP_MARK][CC_PLUS] = S_EXP_SIGN;
+    table[S_EXP_MARK][CC_MINUS] = S_EXP_SIGN;
+    table[S_EXP_DIGITS][CC_UNDERSCORE] = S_EXP_SEP;
+
+    // 十六进制与二进制整数
+    table[S_ZERO][CC_HEX_MARK] = S_HEX_PREFIX;
+    table[S_ZERO][CC_BIN_MARK] = S_BIN_PREFIX;
+    for (uint8_t char_class : kHexDigits) {
+        table[S_HEX_PREFIX][char_class] = S_HEX;
+        table[S_HEX][char_class] = S_HEX;
+        table[S_HEX_SEP][char_class] = S_HEX;
+    }
+    table[S_HEX][CC_UNDERSCORE] = S_HEX_SEP;
+    for (uint8_t char_class : kBinaryDigits) {
+        table[S_BIN_PREFIX][char_class] = S_BIN;
+        table[S_BIN][char_class] = S_BIN;
+        table[S_BIN_SEP][char_class] = S_BIN;
+    }
+    table[S_BIN][CC_UNDERSCORE] = S_BIN_SEP;
+
+    // 双字符操作符
+    table[S_ASSIGN][CC_EQUAL] = S_EQUAL;
+    table[S_BANG][CC_EQUAL] = S_NOT_EQUAL;
+    table[S_LESS][CC_EQUAL] = S_LESS_EQUAL;
+    table[S_GREATER][CC_EQUAL] = S_GREATER_EQUAL;
+    table[S_AMP][CC_AMP] = S_AND;
+    table[S_PIPE][CC_PIPE] = S_OR;
+    table[S_STAR][CC_STAR] = S_POWER;
+
+    // 注释
+    table[S_SLASH][CC_SLASH] = S_LINE_COMMENT;
+    table[S_SLASH][CC_STAR] = S_BLOCK_COMMENT;
+
+    return table;
+}
+
+constexpr std::array<StateInfo, S_COUNT> buildStateInfo() {
+    std::array<StateInfo, S_COUNT> info{};
+    for (auto& entry : info) {
+        entry = {A_BACKTRACK, TokenType::EOF_TOKEN};
+    }
+
+    info[S_START] = {A_UNEXPECTED, TokenType::EOF_TOKEN};
+    info[S_SPACE] = {A_SKIP, TokenType::EOF_TOKEN};
+    info[S_NEWLINE] = {A_TOKEN, TokenType::LINEBREAK};
+    info[S_IDENT] = {A_TOKEN, TokenType::IDENT};
+    info[S_ZERO] = {A_TOKEN, TokenType::NUMBER};
+    info[S_INT] = {A_TOKEN, TokenType::NUMBER};
+    info[S_FRACTION] = {A_TOKEN, TokenType::NUMBER};
+    info[S_EXP_MARK] = {A_BAD_NUMBER, TokenType::NUMBER};
+    info[S_EXP_SIGN] = {A_BAD_NUMBER, TokenType::NUMBER};
+    info[S_EXP_DIGITS] = {A_TOKEN, TokenType::NUMBER};
+    info[S_HEX_PREFIX] = {A_BAD_NUMBER, TokenType::NUMBER};
+    info[S_HEX] = {A_TOKEN, TokenType::NUMBER};
+    info[S_BIN_PREFIX] = {A_BAD_NUMBER, TokenType::NUMBER};
+    info[S_BIN] = {A_TOKEN, TokenType::NUMBER};
+    info[S_ASSIGN] = {A_TOKEN, TokenType::ASSIGN};
+    info[S_EQUAL] = {A_TOKEN, TokenType::EQUAL};
+    info[S_BANG] = {A_TOKEN, TokenType::LOGICAL_NOT};
+    info[S_NOT_EQUAL] = {A_TOKEN, TokenType::NOT_EQUAL};
+    info[S_LESS] = {A_TOKEN, TokenType::LESS};
+    info[S_LESS_EQUAL] = {A_TOKEN, TokenType::LESS_EQUAL};
+    info[S_GREATER] = {A_TOKEN, TokenType::GREATER};
+    info[S_GREATER_EQUAL] = {A_TOKEN, TokenType::GREATER_EQUAL};
+    info[S_AMP] = {A_BAD_OPERATOR, TokenType::LOGICAL_AND};
+    info[S_AND] = {A_TOKEN, TokenType::LOGICAL_AND};
+    info[S_PIPE] = {A_BAD_OPERATOR, TokenType::LOGICAL_OR};
+    info[S_OR] = {A_TOKEN, TokenType::LOGICAL_OR};
+    info[S_STAR] = {A_TOKEN, TokenType::MULT};
+    info[S_POWER] = {A_TOKEN, TokenType::POWER};
+    info[S_SLASH] = {A_TOKEN, TokenType::DIVIDE};
+    info[S_LINE_COMMENT] = {A_LINE_COMMENT, TokenType::SINGLE_COMMENT};
+    info[S_BLOCK_COMMENT] = {A_BLOCK_COMMENT, TokenType::MULTI_COMMENT};
+    info[S_STRING] = {A_STRING, TokenType::STRING};
+    info[S_CHAR] = {A_CHAR, TokenType::CHAR};
+    info[S_PLUS] = {A_TOKEN, TokenType::PLUS};
+    info[S_MINUS] = {A_TOKEN, TokenType::MINUS};
+    info[S_PERCENT] = {A_TOKEN, TokenType::MODULO};
+    info[S_DOT] = {A_TOKEN, TokenType::DOT};
+    info[S_COMMA] = {A_TOKEN, TokenType::COMMA};
+    info[S_COLON] = {A_TOKEN, TokenType::COLON};
+    info[S_SEMICOLON] = {A_TOKEN, TokenType::SEMICOLON};
+    info[S_LPAREN] = {A_TOKEN, TokenType::LEFT_PAREN};
+    info[S_RPAREN] = {A_TOKEN, TokenType::RIGHT_PAREN};
+    info[S_LBRACKET] = {A_TOKEN, TokenType::LEFT_BRACKET};
+    info[S_RBRACKET] = {A_TOKEN, TokenType::RIGHT_BRACKET};
+    info[S_LBRACE] = {A_TOKEN, TokenType::LEFT_BRACE};
+    info[S_RBRACE] = {A_TOKEN, TokenType::RIGHT_BRACE};
+
+    return info;
+}
+
+constexpr CharClassTable kCharClasses = buildCharClasses();
+constexpr TransitionTable kTransitions = buildTransitions();
+constexpr std::array<StateInfo, S_COUNT> kStateInfo = buildStateInfo();
+
+} // namespace
+
+template <typename Policy>
+Token BasicLexical<Policy>::nextTokenTable() {
+    const char* source = source_.data();
+    const size_t size = source_.size();
+
+    while (true) {
+        token_start_ = index_;
+
+        if (isAtEnd()) {
+            return makeToken(TokenType::EOF_TOKEN);
+        }
+
+        // 运行DFA直到无法转移，同时记录最近一次到达接受状态的位置
+        uint8_t state = S_START;
+        size_t pos = index_;
+        uint8_t accept_state = S_START;
+        size_t accept_pos = pos;
+
+        while (true) {
+            uint8_t char_class =
+                    pos < size ? kCharClasses[static_cast<unsigned char>(source[pos])] : static_cast<uint8_t>(CC_END);
+            uint8_t next = kTransitions[state][char_class];
+            if (next == S_DEAD) {
+                break;
+            }
+            state = next;
+            ++pos;
+            Action action = kStateInfo[state].action;
+            if (action == A_TOKEN || action == A_SKIP) {
+                accept_state = state;
+                accept_pos = pos;
+            }
+        }
+
+        if (kStateInfo[state].action == A_BACKTRACK) {
+            state = accept_state;
+            pos = accept_pos;
+        }
+
+        const StateInfo& info = kStateInfo[state];
+        switch (info.action) {
+            case A_SKIP:
+                advanceBy(pos - index_);
+                if constexpr (Policy::kRetainTrivia) {
+                    recordTrivia(TriviaKind::WHITESPACE, token_start_);
+                }
+                continue;
+
+            case A_TOKEN: {
+                if (info.type == TokenType::LINEBREAK) {
+                    advance();
+                    if constexpr (!Policy::kEmitTrivia) {
+                        if constexpr (Policy::kRetainTrivia) {
+                            recordTrivia(TriviaKind::NEWLINE, token_start_);
+                        }
+                        // 与产生换行Token时一样在此验证UTF-8，错误的报告顺序不受策略影响
+                        if (index_ > utf8_checked_) {
+                            checkUtf8();
+                        }
+                        continue;
+                    }
+                    return makeToken(TokenType::LINEBREAK, sourceSlice(token_start_));
+                }
+                advanceBy(pos - index_);
+                if (info.type == TokenType::NUMBER) {
+                    return makeNumberToken();
+                }
+                if (info.type == TokenType::IDENT) {
+                    return makeWordToken(sourceSlice(token_start_));
+                }
+                return makeToken(info.type, sourceSlice(token_start_));
+            }
+
+            case A_STRING:
+                return readString();
+
+            case A_CHAR:
+                return readChar();
+
+            case A_LINE_COMMENT:
+                skipSingleLineComment();
+                continue;
+
+            case A_BLOCK_COMMENT:
+                if (!skipMultiLineComment()) {
+                    return errorToken(_("Unterminated comment"), '*', "MULTI_COMMENT", index_);
+                }
+                continue;
+
+            case A_BAD_NUMBER:
+                advanceBy(pos - index_);
+                return errorToken(_("Invalid number format"), currentChar(), "NUMBER", index_);
+
+            case A_BAD_OPERATOR:
+                advanceBy(pos - index_);
+                return errorToken(_("Invalid character"), source[token_start_], "UNKNOWN", index_);
+
+            default:
+                return errorToken(_("Unexpected character"), currentChar(), "UNKNOWN", nextCharBoundary(index_));
+        }
+    }
+}
+
+template Token BasicLexical<DefaultLexPolicy>::nextTokenTable();
+template Token BasicLexical<CountingLexPolicy>::nextTokenTable();
+template Token BasicLexical<StatisticsLexPolicy>::nextTokenTable();
+template Token BasicLexical<TriviaLexPolicy>::nextTokenTable();
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,54 @@
+#include "lexer/line_index.h"
+#include "lexer/simd_scan.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace dreamlang::lexer {
+
+LineIndex::LineIndex(std::string_view source) {
+    simd::collectByteOffsets(source.data(), source.size(), '\n', newlines_);
+}
+
+SourcePosition LineIndex::resolve(size_t offset) const {
+    // 偏移之前的换行符个数即为 0 基行号
+    auto it = std::lower_bound(newlines_.begin(), newlines_.end(), offset);
+    size_t line = it - newlines_.begin();
+    size_t start = line == 0 ? 0 : newlines_[line - 1] + 1;
+    return {static_cast<int>(line) + 1, static_cast<int>(offset - start) + 1};
+}
+
+int LineIndex::lineOf(size_t offset) const {
+    auto it = std::lower_bound(newlines_.begin(), newlines_.end(), offset);
+    return static_cast<int>(it - newlines_.begin()) + 1;
+}
+
+size_t LineIndex::lineStart(int line) const {
+    if (line < 1 || static_cast<size_t>(line) > lineCount()) {
+        throw std::out_of_range("Line is outside of the source");
+    }
+    // 第 line 行从第 line - 1 个换行符之后开始
+    return line == 1 ? 0 : newlines_[line - 2] + 1;
+}
+
+void LineIndex::applyEdit(std::string_view new_source, size_t offset, size_t old_length, size_t new_length) {
+    auto first = std::lower_bound(newlines_.begin(), newlines_.end(), offset);
+    auto last = std::lower_bound(first, newlines_.end(), offset + old_length);
+
+    // 编辑之后的换行符整体平移
+    auto delta = static_cast<uint32_t>(new_length - old_length);
+    for (auto it = last; it != newlines_.end(); ++it) {
+        *it += delta;
+    }
+
+    std::vector<uint32_t> inserted;
+    simd::collectByteOffsets(new_source.data() + offset, new_length, '\n', inserted);
+    for (auto& position : inserted) {
+        position += static_cast<uint32_t>(offset);
+    }
+
+    size_t index = first - newlines_.begin();
+    newlines_.erase(first, last);
+    newlines_.insert(newlines_.begin() + index, inserted.begin(), inserted.end());
+}
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,165 @@
+#include "lexer/number_literal.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace dreamlang::lexer {
+
+namespace {
+
+// 估计十进制字面量的数量级（科学计数法下的十进制指数加一），用于区分上溢与下溢
+int64_t decimalMagnitude(std::string_view text) {
+    size_t exponent_pos = text.find_first_of("eE");
+    std::string_view mantissa = text.substr(0, exponent_pos);
+
+    int64_t exponent = 0;
+    if (exponent_pos != std::string_view::npos) {
+        std::string_view digits = text.substr(exponent_pos + 1);
+        bool negative = !digits.empty() && digits[0] == '-';
+        if (!digits.empty() && (digits[0] == '-' || digits[0] == '+')) {
+            digits.remove_prefix(1);
+        }
+        // 指数本身过大时截断即可，只需要符号正确
+        if (std::from_chars(digits.data(), digits.data() + digits.size(), exponent).ec != std::errc()) {
+            exponent = std::numeric_limits<int32_t>::max();
+        }
+        exponent = negative ? -exponent : exponent;
+    }
+
+    std::string_view integer_part = mantissa.substr(0, mantissa.find('.'));
+    size_t first_significant = integer_part.find_first_not_of('0');
+    if (first_significant != std::string_view::npos) {
+        return exponent + static_cast<int64_t>(integer_part.size() - first_significant);
+    }
+
+    // 整数部分为 0 时按小数部分的前导零计算
+    std::string_view fraction = mantissa.substr(std::min(integer_part.size() + 1, mantissa.size()));
+    size_t leading_zeros = fraction.find_first_not_of('0');
+    return exponent - static_cast<int64_t>(leading_zeros == std::string_view::npos ? fraction.size() : leading_zeros);
+}
+
+// 十进制尾数中的有效数字（去掉小数点和首尾的 0）
+std::string significantDigits(std::string_view mantissa) {
+    std::string digits;
+    digits.reserve(mantissa.size());
+    for (char c : mantissa) {
+        if (c != '.' && (c != '0' || !digits.empty())) {
+            digits.push_back(c);
+        }
+    }
+    digits.erase(digits.find_last_not_of('0') + 1);
+    return digits;
+}
+
+// 判断 value 的最短十进制表示是否与字面量的有效数字和数量级一致
+bool losesPrecision(std::string_view text, double value) {
+    std::string digits = significantDigits(text.substr(0, text.find_first_of("eE")));
+    // 不超过 DBL_DIG 位有效数字的十进制数在正规数范围内总能从 double 还原
+    if (digits.size() <= static_cast<size_t>(std::numeric_limits<double>::digits10) && (value == 0.0 || std::isnormal(value))) {
+        return false;
+    }
+
+    // 最短表示形如 "d.ddde+XX"
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific);
+    std::string_view shortest(buffer, static_cast<size_t>(result.ptr - buffer));
+    size_t exponent_pos = shortest.find('e');
+    int64_t exponent = 0;
+    std::string_view exponent_text = shortest.substr(exponent_pos + 1);
+    if (exponent_text[0] == '+') {
+        exponent_text.remove_prefix(1);
+    }
+    std::from_chars(exponent_text.data(), exponent_text.data() + exponent_text.size(), exponent);
+
+    return significantDigits(shortest.substr(0, exponent_pos)) != digits ||
+           (!digits.empty() && exponent + 1 != decimalMagnitude(text));
+}
+
+} // namespace
+
+uint64_t NumberLiteral::payload() const {
+    uint64_t bits;
+    if (kind == NumberKind::FLOAT) {
+        std::memcpy(&bits, &floating, sizeof(bits));
+    } else {
+        std::memcpy(&bits, &integer, sizeof(bits));
+    }
+    return bits;
+}
+
+uint8_t NumberLiteral::flags() const {
+    return (kind == NumberKind::FLOAT ? kFloatFlag : 0) | (out_of_range ? kOutOfRangeFlag : 0) |
+           (inexact ? kInexactFlag : 0);
+}
+
+NumberLiteral NumberLiteral::fromPayload(uint64_t payload, uint8_t flags) {
+    NumberLiteral literal;
+    literal.kind = (flags & kFloatFlag) ? NumberKind::FLOAT : NumberKind::INTEGER;
+    literal.out_of_range = (flags & kOutOfRangeFlag) != 0;
+    literal.inexact = (flags & kInexactFlag) != 0;
+    if (literal.kind == NumberKind::FLOAT) {
+        std::memcpy(&literal.floating, &payload, sizeof(payload));
+    } else {
+        std::memcpy(&literal.integer, &payload, sizeof(payload));
+    }
+    return literal;
+}
+
+NumberLiteral parseNumberLiteral(std::string_view text) {
+    // 分隔符很少见，只有出现时才复制一份去掉分隔符的文本
+    std::string stripped;
+    if (text.find('_') != std::string_view::npos) {
+        stripped.reserve(text.size());
+        for (char c : text) {
+            if (c != '_') {
+                stripped.push_back(c);
+            }
+        }
+        text = stripped;
+    }
+
+    int base = 10;
+    if (text.size() > 2 && text[0] == '0') {
+        if (text[1] == 'x' || text[1] == 'X') {
+            base = 16;
+        } else if (text[1] == 'b' || text[1] == 'B') {
+            base = 2;
+        }
+        if (base != 10) {
+            text.remove_prefix(2);
+        }
+    }
+
+    const char* first = text.data();
+    const char* last = text.data() + text.size();
+    NumberLiteral literal;
+
+    if (base != 10 || text.find_first_of(".eE") == std::string_view::npos) {
+        uint64_t value = 0;
+        auto result = std::from_chars(first, last, value, base);
+        if (result.ec == std::errc::result_out_of_range ||
+            value > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            literal.integer = std::numeric_limits<int64_t>::max();
+            literal.out_of_range = true;
+        } else {
+            literal.integer = static_cast<int64_t>(value);
+        }
+        return literal;
+    }
+
+    literal.kind = NumberKind::FLOAT;
+    auto result = std::from_chars(first, last, literal.floating);
+    if (result.ec == std::errc::result_out_of_range) {
+        // from_chars 在超出范围时不写入结果，按数量级补上无穷或 0
+        literal.floating = decimalMagnitude(text) > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+        literal.out_of_range = true;
+    } else {
+        literal.inexact = losesPrecision(text, literal.floating);
+    }
+    return literal;
+}
+
+} // namespace dreamlang::lexer
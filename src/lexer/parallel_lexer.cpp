@@ -0,0 +1,256 @@
+#include "lexer/parallel_lexer.h"
+#include "lexer/simd_scan.h"
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace dreamlang::lexer {
+
+namespace {
+
+// 单个分块的分析结果
+struct ChunkResult {
+    TokenBuffer tokens;
+    // 推测分析的分块先把标识符驻留在这张局部表中，拼接时确认可信后才转入共享符号表
+    std::unique_ptr<SymbolTable> symbols;
+    // 第一个越过分块终点的Token的起点（complete 为真时有效）
+    size_t next_start = 0;
+    // 是否正常分析到分块终点；分块起点落在字符串或注释中时可能提前出错
+    bool complete = false;
+    // 词法错误以外的异常（如内存不足），在汇合后重新抛出
+    std::exception_ptr failure;
+};
+
+/**
+ * 在换行处切分，返回各分块的起点（首项为 0），最后一个分块延伸到末尾
+ */
+std::vector<size_t> splitAtNewlines(std::string_view source, size_t chunk_count) {
+    std::vector<size_t> begins{0};
+    for (size_t i = 1; i < chunk_count; ++i) {
+        size_t target = std::max(source.size() / chunk_count * i, begins.back());
+        size_t newline = simd::findByte(source.data(), target, source.size(), '\n');
+        if (newline + 1 >= source.size()) {
+            break;
+        }
+        if (newline + 1 > begins.back()) {
+            begins.push_back(newline + 1);
+        }
+    }
+    return begins;
+}
+
+void lexChunk(std::string_view source, size_t begin, size_t end, const ParallelOptions& options,
+              ChunkResult& result) {
+    try {
+        Lexical lexer(source, options.engine);
+        lexer.setSymbolTable(result.symbols != nullptr ? result.symbols.get() : options.symbols);
+        lexer.seek(begin);
+        while (true) {
+            Token token = lexer.nextToken();
+            if (token.getOffset() >= end) {
+                result.next_start = token.getOffset();
+                result.complete = true;
+                return;
+            }
+            result.tokens.push(token);
+            if (token.getType() == TokenType::EOF_TOKEN) {
+                result.complete = true;
+                return;
+            }
+        }
+    } catch (const LexicalException&) {
+        // 可能只是因为起点落在字符串或注释内部，拼接时再从确定的位置重新分析
+        result.complete = false;
+    } catch (...) {
+        result.failure = std::current_exception();
+    }
+}
+
+/**
+ * 把分块中从 first 开始的（已确认可信的）Token追加到输出
+ *
+ * 分块带有局部符号表时，按源码顺序把其中出现的标识符转驻留到共享符号表并改写编号，
+ * 起点未对齐而被丢弃的部分因此不会在共享表中留下名字。
+ */
+void commitChunk(const ChunkResult& chunk, size_t first, SymbolTable* symbols, TokenBuffer& output) {
+    if (chunk.symbols == nullptr) {
+        output.append(chunk.tokens, first);
+        return;
+    }
+    std::vector<SymbolId> remap(chunk.symbols->size(), SymbolTable::kInvalidSymbol);
+    for (size_t i = first; i < chunk.tokens.size(); ++i) {
+        Token token = chunk.tokens[i];
+        if (token.getType() == TokenType::IDENT) {
+            SymbolId& global = remap[token.getSymbol()];
+            if (global == SymbolTable::kInvalidSymbol) {
+                global = symbols->intern(token.getValue());
+            }
+            token = Token(TokenType::IDENT, token.getValue(), token.getOffset(), token.getLength(), global);
+        }
+        output.push(token);
+    }
+}
+
+/**
+ * 汇合所有已启动的线程（启动中途抛出异常时同样汇合，不留下可汇合的 std::thread）
+ */
+struct JoinGuard {
+    std::vector<std::thread>& threads;
+
+    ~JoinGuard() {
+        for (auto& thread : threads) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+    }
+};
+
+/**
+ * 顺序重新分析的结果
+ */
+struct RelexOutcome {
+    // 是否遇到了分块中已有的Token起点（此后可直接复用分块结果）
+    bool synced;
+    // synced 时为分块中的下标，否则为越过分块终点的第一个Token的起点
+    size_t position;
+};
+
+/**
+ * 从确定的位置 resume 顺序分析，直到与分块结果 known 对齐或越过分块终点
+ */
+RelexOutcome relex(std::string_view source, const ParallelOptions& options, size_t resume, size_t end,
+                   const TokenBuffer& known, TokenBuffer& output) {
+    Lexical lexer(source, options.engine);
+    lexer.setSymbolTable(options.symbols);
+    lexer.setFileLocation(options.file_start);
+    lexer.seek(resume);
+    while (true) {
+        Token token = lexer.nextToken();
+        if (token.getOffset() >= end) {
+            return {false, token.getOffset()};
+        }
+
+        size_t count = known.size();
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (known.offset(mid) < token.getOffset()) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low < count && known.offset(low) == token.getOffset()) {
+            return {true, low};
+        }
+
+        output.push(token);
+        if (token.getType() == TokenType::EOF_TOKEN) {
+            return {false, std::numeric_limits<size_t>::max()};
+        }
+    }
+}
+
+} // namespace
+
+TokenBuffer tokenizeParallel(std::string_view source, const ParallelOptions& options) {
+    unsigned threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    size_t min_chunk_size = std::max<size_t>(options.min_chunk_size, 1);
+    size_t chunk_count = std::min<size_t>(threads, std::max<size_t>(source.size() / min_chunk_size, 1));
+
+    if (chunk_count <= 1) {
+        Lexical lexer(source, options.engine);
+        lexer.setSymbolTable(options.symbols);
+        lexer.setFileLocation(options.file_start);
+        if (options.resource != nullptr) {
+            lexer.setMemoryResource(options.resource);
+        }
+        return lexer.tokenize();
+    }
+
+    std::vector<size_t> begins = splitAtNewlines(source, chunk_count);
+    std::vector<size_t> ends(begins.begin() + 1, begins.end());
+    // 最后一个分块一直分析到EOF
+    ends.push_back(std::numeric_limits<size_t>::max());
+
+    std::vector<ChunkResult> results(begins.size());
+    for (size_t i = 0; i < results.size(); ++i) {
+        results[i].tokens = TokenBuffer(source);
+        // 第一个分块从源码开头分析，结果总是可信，可以直接驻留到共享符号表
+        if (i > 0 && options.symbols != nullptr) {
+            results[i].symbols = std::make_unique<SymbolTable>();
+        }
+    }
+
+    {
+        std::vector<std::thread> workers;
+        JoinGuard join_guard{workers};
+        workers.reserve(begins.size() - 1);
+        for (size_t i = 1; i < begins.size(); ++i) {
+            workers.emplace_back(lexChunk, source, begins[i], ends[i], std::cref(options), std::ref(results[i]));
+        }
+        lexChunk(source, begins[0], ends[0], options, results[0]);
+    }
+    for (const auto& result : results) {
+        if (result.failure) {
+            std::rethrow_exception(result.failure);
+        }
+    }
+
+    // 按顺序拼接：next 为下一个Token的确定起点
+    TokenBuffer output(source, options.resource != nullptr ? options.resource : std::pmr::get_default_resource());
+    size_t total = 0;
+    for (const auto& result : results) {
+        total += result.tokens.size();
+    }
+    output.reserve(total);
+
+    size_t next = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ChunkResult& chunk = results[i];
+        size_t first = 0;
+
+        // 第一个分块从源码开头分析，结果全部可信；其余分块需要在 next 处对齐
+        if (i > 0) {
+            RelexOutcome outcome = relex(source, options, next, ends[i], chunk.tokens, output);
+            if (!outcome.synced) {
+                if (outcome.position == std::numeric_limits<size_t>::max()) {
+                    return output;
+                }
+                next = outcome.position;
+                continue;
+            }
+            first = outcome.position;
+        }
+
+        commitChunk(chunk, first, options.symbols, output);
+
+        if (chunk.complete) {
+            if (i + 1 == results.size()) {
+                return output;
+            }
+            next = chunk.next_start;
+            continue;
+        }
+
+        // 分块在中途出错：从最后一个可信Token之后顺序重新分析，真正的错误会在此抛出
+        size_t resume = first < chunk.tokens.size()
+                                ? chunk.tokens.offset(chunk.tokens.size() - 1) + chunk.tokens.length(chunk.tokens.size() - 1)
+                                : (i > 0 ? next : begins[0]);
+        RelexOutcome outcome = relex(source, options, resume, ends[i], TokenBuffer(), output);
+        if (outcome.position == std::numeric_limits<size_t>::max()) {
+            return output;
+        }
+        next = outcome.position;
+    }
+
+    return output;
+}
+
+} // namespace dreamlang::lexer
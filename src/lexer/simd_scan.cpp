@@ -0,0 +1,493 @@
+#include "lexer/simd_scan.h"
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+    #define DREAMLANG_SIMD_X86 1
+    #include <immintrin.h>
+#else
+    #define DREAMLANG_SIMD_X86 0
+#endif
+
+namespace dreamlang::lexer::simd {
+
+namespace {
+
+// 单组内核实现
+struct Kernels {
+    size_t (*find_byte)(const char*, size_t, size_t, char);
+    size_t (*find_either_byte)(const char*, size_t, size_t, char, char);
+    size_t (*skip_blanks)(const char*, size_t, size_t);
+    size_t (*count_byte)(const char*, size_t, size_t, char);
+    void (*collect_byte_offsets)(const char*, size_t, char, std::vector<uint32_t>&);
+    size_t (*validate_utf8)(const char*, size_t, size_t);
+    const char* name;
+};
+
+inline bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// ---------------------------------------------------------------------------
+// 标量实现（同时用于向量实现的尾部处理）
+// ---------------------------------------------------------------------------
+
+size_t findByteScalar(const char* data, size_t pos, size_t size, char c) {
+    if (pos >= size) {
+        return size;
+    }
+    const void* found = std::memchr(data + pos, c, size - pos);
+    return found != nullptr ? static_cast<const char*>(found) - data : size;
+}
+
+size_t findEitherByteScalar(const char* data, size_t pos, size_t size, char a, char b) {
+    for (; pos < size; ++pos) {
+        if (data[pos] == a || data[pos] == b) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+size_t skipBlanksScalar(const char* data, size_t pos, size_t size) {
+    while (pos < size && isBlank(data[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+size_t countByteScalar(const char* data, size_t begin, size_t end, char c) {
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+        count += data[i] == c;
+    }
+    return count;
+}
+
+void collectByteOffsetsScalar(const char* data, size_t size, char c, std::vector<uint32_t>& offsets) {
+    for (size_t pos = findByteScalar(data, 0, size, c); pos < size; pos = findByteScalar(data, pos + 1, size, c)) {
+        offsets.push_back(static_cast<uint32_t>(pos));
+    }
+}
+
+// 从 p 开始的一个合法UTF-8字符的字节数，非法（含被 available 截断）时返回 0
+inline size_t utf8SequenceLength(const unsigned char* p, size_t available) {
+    unsigned char lead = p[0];
+    if (lead < 0x80) {
+        return 1;
+    }
+    // 0x80-0xBF 是续字节，0xC0/0xC1 只能构成过长编码，0xF5 以上超出 U+10FFFF
+    if (lead < 0xC2 || lead > 0xF4) {
+        return 0;
+    }
+    size_t length = lead < 0xE0 ? 2 : (lead < 0xF0 ? 3 : 4);
+    if (available < length) {
+        return 0;
+    }
+    // 第二个字节的合法范围排除过长编码（E0/F0）、代理项（ED）和超出范围的码点（F4）
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead == 0xE0) {
+        low = 0xA0;
+    } else if (lead == 0xED) {
+        high = 0x9F;
+    } else if (lead == 0xF0) {
+        low = 0x90;
+    } else if (lead == 0xF4) {
+        high = 0x8F;
+    }
+    if (p[1] < low || p[1] > high) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; ++i) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+size_t validateUtf8Scalar(const char* data, size_t pos, size_t size) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    while (pos < size) {
+        size_t length = utf8SequenceLength(bytes + pos, size - pos);
+        if (length == 0) {
+            return pos;
+        }
+        pos += length;
+    }
+    return size;
+}
+
+#if DREAMLANG_SIMD_X86
+
+// 把一个块内命中位置的位掩码展开为偏移
+inline void appendMaskOffsets(uint32_t mask, size_t base, std::vector<uint32_t>& offsets) {
+    while (mask != 0) {
+        offsets.push_back(static_cast<uint32_t>(base + __builtin_ctz(mask)));
+        mask &= mask - 1;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// SSE2 实现：每次处理 16 字节
+// ---------------------------------------------------------------------------
+
+__attribute__((target("sse2"))) size_t findByteSse2(const char* data, size_t pos, size_t size, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return findByteScalar(data, pos, size, c);
+}
+
+__attribute__((target("sse2"))) size_t findEitherByteSse2(const char* data, size_t pos, size_t size, char a,
+                                                          char b) {
+    const __m128i needle_a = _mm_set1_epi8(a);
+    const __m128i needle_b = _mm_set1_epi8(b);
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, needle_a), _mm_cmpeq_epi8(chunk, needle_b));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return findEitherByteScalar(data, pos, size, a, b);
+}
+
+__attribute__((target("sse2"))) size_t skipBlanksSse2(const char* data, size_t pos, size_t size) {
+    // 空白通常很短，先用标量判断，避免为一两个空格装载整个向量
+    if (pos < size && !isBlank(data[pos])) {
+        return pos;
+    }
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i blanks = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, space), _mm_cmpeq_epi8(chunk, tab)),
+                                      _mm_cmpeq_epi8(chunk, cr));
+        int mask = ~_mm_movemask_epi8(blanks) & 0xFFFF;
+        if (mask != 0) {
+            return pos + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+    }
+    return skipBlanksScalar(data, pos, size);
+}
+
+__attribute__((target("sse2"))) size_t countByteSse2(const char* data, size_t begin, size_t end, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t count = 0;
+    size_t pos = begin;
+    for (; pos + 16 <= end; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))));
+    }
+    return count + countByteScalar(data, pos, end, c);
+}
+
+__attribute__((target("sse2"))) void collectByteOffsetsSse2(const char* data, size_t size, char c,
+                                                            std::vector<uint32_t>& offsets) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t pos = 0;
+    for (; pos + 16 <= size; pos += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        appendMaskOffsets(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))), pos, offsets);
+    }
+    for (; pos < size; ++pos) {
+        if (data[pos] == c) {
+            offsets.push_back(static_cast<uint32_t>(pos));
+        }
+    }
+}
+
+__attribute__((target("sse2"))) size_t validateUtf8Sse2(const char* data, size_t pos, size_t size) {
+    // 纯ASCII的 16 字节块整块跳过，其余逐字符验证
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    while (pos < size) {
+        if (pos + 16 <= size &&
+            _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos))) == 0) {
+            pos += 16;
+            continue;
+        }
+        size_t block_end = std::min(pos + 16, size);
+        while (pos < block_end) {
+            size_t length = utf8SequenceLength(bytes + pos, size - pos);
+            if (length == 0) {
+                return pos;
+            }
+            pos += length;
+        }
+    }
+    return size;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2 实现：每次处理 32 字节
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2"))) size_t findByteAvx2(const char* data, size_t pos, size_t size, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+    return findByteSse2(data, pos, size, c);
+}
+
+__attribute__((target("avx2"))) size_t findEitherByteAvx2(const char* data, size_t pos, size_t size, char a,
+                                                          char b) {
+    const __m256i needle_a = _mm256_set1_epi8(a);
+    const __m256i needle_b = _mm256_set1_epi8(b);
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, needle_a), _mm256_cmpeq_epi8(chunk, needle_b));
+        auto mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+    return findEitherByteSse2(data, pos, size, a, b);
+}
+
+__attribute__((target("avx2"))) size_t skipBlanksAvx2(const char* data, size_t pos, size_t size) {
+    if (pos < size && !isBlank(data[pos])) {
+        return pos;
+    }
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        __m256i blanks = _mm256_or_si256(
+                _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, tab)),
+                _mm256_cmpeq_epi8(chunk, cr));
+        auto mask = ~static_cast<unsigned>(_mm256_movemask_epi8(blanks));
+        if (mask != 0) {
+            return pos + __builtin_ctz(mask);
+        }
+    }
+    return skipBlanksSse2(data, pos, size);
+}
+
+__attribute__((target("avx2"))) size_t countByteAvx2(const char* data, size_t begin, size_t end, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t count = 0;
+    size_t pos = begin;
+    for (; pos + 32 <= end; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))));
+    }
+    return count + countByteSse2(data, pos, end, c);
+}
+
+__attribute__((target("avx2"))) void collectByteOffsetsAvx2(const char* data, size_t size, char c,
+                                                            std::vector<uint32_t>& offsets) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t pos = 0;
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        appendMaskOffsets(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))), pos,
+                          offsets);
+    }
+    for (; pos < size; ++pos) {
+        if (data[pos] == c) {
+            offsets.push_back(static_cast<uint32_t>(pos));
+        }
+    }
+}
+
+// UTF-8 验证采用 Keiser 与 Lemire 的查表法：用前一字节的高低半字节和当前字节的
+// 高半字节查三张表，三者按位与得到 2 字节范围内的错误；再用前两、三个字节判断
+// 当前字节是否必须是 3、4 字节序列的续字节。
+namespace utf8_lookup {
+
+constexpr uint8_t kTooShort = 1 << 0;
+constexpr uint8_t kTooLong = 1 << 1;
+constexpr uint8_t kOverlong3 = 1 << 2;
+constexpr uint8_t kTooLarge = 1 << 3;
+constexpr uint8_t kSurrogate = 1 << 4;
+constexpr uint8_t kOverlong2 = 1 << 5;
+constexpr uint8_t kTooLarge1000 = 1 << 6;
+constexpr uint8_t kOverlong4 = 1 << 6;
+constexpr uint8_t kTwoConts = 1 << 7;
+constexpr uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+// 按前一字节的高半字节
+alignas(16) constexpr uint8_t kByte1High[16] = {
+        // 0_______：ASCII
+        kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+        // 10______：续字节
+        kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+        // 1100____、1101____：2 字节序列首字节
+        kTooShort | kOverlong2, kTooShort,
+        // 1110____：3 字节序列首字节
+        kTooShort | kOverlong3 | kSurrogate,
+        // 1111____：4 字节序列首字节
+        kTooShort | kTooLarge | kTooLarge1000 | kOverlong4};
+
+// 按前一字节的低半字节
+alignas(16) constexpr uint8_t kByte1Low[16] = {
+        kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+        kCarry | kOverlong2,
+        kCarry,
+        kCarry,
+        kCarry | kTooLarge,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+        kCarry | kTooLarge | kTooLarge1000,
+        kCarry | kTooLarge | kTooLarge1000};
+
+// 按当前字节的高半字节
+alignas(16) constexpr uint8_t kByte2High[16] = {
+        // 0_______：ASCII
+        kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+        // 1000____、1001____、101_____：续字节
+        kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+        kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+        kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+        kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+        // 11______：首字节
+        kTooShort, kTooShort, kTooShort, kTooShort};
+
+} // namespace utf8_lookup
+
+// 把 16 字节的查找表复制到两个 128 位通道
+__attribute__((target("avx2"))) inline __m256i loadTable(const uint8_t (&table)[16]) {
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+__attribute__((target("avx2"))) inline __m256i lookup16(__m256i table, __m256i index) {
+    return _mm256_shuffle_epi8(table, index);
+}
+
+__attribute__((target("avx2"))) inline __m256i highNibbles(__m256i bytes) {
+    return _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0F));
+}
+
+// 检查一个 32 字节块，previous 为前一块（用于跨块的前三个字节），返回非零表示有错误
+__attribute__((target("avx2"))) __m256i checkUtf8Block(__m256i input, __m256i previous) {
+    using namespace utf8_lookup;
+    // 把前一块的后半部分与当前块拼接，得到每个字节之前第 1、2、3 个字节
+    __m256i carried = _mm256_permute2x128_si256(previous, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, carried, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, carried, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, carried, 13);
+
+    const __m256i byte1_high_table = loadTable(kByte1High);
+    const __m256i byte1_low_table = loadTable(kByte1Low);
+    const __m256i byte2_high_table = loadTable(kByte2High);
+
+    __m256i special = _mm256_and_si256(
+            _mm256_and_si256(lookup16(byte1_high_table, highNibbles(prev1)),
+                             lookup16(byte1_low_table, _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)))),
+            lookup16(byte2_high_table, highNibbles(input)));
+
+    // 只有 111_____ 减去 0x60、1111____ 减去 0x70 后最高位仍为 1
+    __m256i third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    __m256i must_continue =
+            _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    return _mm256_xor_si256(must_continue, special);
+}
+
+__attribute__((target("avx2"))) size_t validateUtf8Avx2(const char* data, size_t pos, size_t size) {
+    const size_t start = pos;
+    // pos 位于字符边界，因此第一块之前视为ASCII
+    __m256i previous = _mm256_setzero_si256();
+    __m256i error = _mm256_setzero_si256();
+    for (; pos + 32 <= size; pos += 32) {
+        __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + pos));
+        // 本块与前一块末尾都是ASCII时不可能有错误
+        if (_mm256_movemask_epi8(input) == 0 && (_mm256_movemask_epi8(previous) & 0xE0000000u) == 0) {
+            previous = input;
+            continue;
+        }
+        error = _mm256_or_si256(error, checkUtf8Block(input, previous));
+        if (!_mm256_testz_si256(error, error)) {
+            // 出错是少见情形，交给标量实现定位确切位置
+            return validateUtf8Scalar(data, start, size);
+        }
+        previous = input;
+    }
+
+    // 尾部补零成整块：末尾不完整的序列后面跟着 0 字节，会被判为过短
+    alignas(32) char tail[32] = {};
+    std::memcpy(tail, data + pos, size - pos);
+    __m256i input = _mm256_load_si256(reinterpret_cast<const __m256i*>(tail));
+    error = _mm256_or_si256(error, checkUtf8Block(input, previous));
+    if (!_mm256_testz_si256(error, error)) {
+        return validateUtf8Scalar(data, start, size);
+    }
+    return size;
+}
+
+#endif // DREAMLANG_SIMD_X86
+
+Kernels selectKernels() {
+#if DREAMLANG_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return {findByteAvx2,           findEitherByteAvx2, skipBlanksAvx2, countByteAvx2,
+                collectByteOffsetsAvx2, validateUtf8Avx2,   "avx2"};
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return {findByteSse2,           findEitherByteSse2, skipBlanksSse2, countByteSse2,
+                collectByteOffsetsSse2, validateUtf8Sse2,   "sse2"};
+    }
+#endif
+    return {findByteScalar,           findEitherByteScalar, skipBlanksScalar, countByteScalar,
+            collectByteOffsetsScalar, validateUtf8Scalar,   "scalar"};
+}
+
+const Kernels& kernels() {
+    static const Kernels selected = selectKernels();
+    return selected;
+}
+
+} // namespace
+
+size_t findByte(const char* data, size_t pos, size_t size, char c) {
+    return kernels().find_byte(data, pos, size, c);
+}
+
+size_t findEitherByte(const char* data, size_t pos, size_t size, char a, char b) {
+    return kernels().find_either_byte(data, pos, size, a, b);
+}
+
+size_t skipBlanks(const char* data, size_t pos, size_t size) {
+    return kernels().skip_blanks(data, pos, size);
+}
+
+size_t countByte(const char* data, size_t begin, size_t end, char c) {
+    return kernels().count_byte(data, begin, end, c);
+}
+
+void collectByteOffsets(const char* data, size_t size, char c, std::vector<uint32_t>& offsets) {
+    kernels().collect_byte_offsets(data, size, c, offsets);
+}
+
+size_t validateUtf8(const char* data, size_t pos, size_t size) {
+    return kernels().validate_utf8(data, pos, size);
+}
+
+const char* activeKernelName() {
+    return kernels().name;
+}
+
+} // namespace dreamlang::lexer::simd
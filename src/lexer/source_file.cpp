@@ -0,0 +1,173 @@
+#include "lexer/source_file.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+    #include <sys/stat.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace dreamlang::lexer {
+
+namespace {
+
+std::runtime_error ioError(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+// 单次 read()，自动重试被信号中断的调用
+size_t readSome(int fd, char* buffer, size_t size, const std::string& name) {
+    while (true) {
+#ifdef _WIN32
+        int count = _read(fd, buffer, static_cast<unsigned int>(size));
+#else
+        ssize_t count = ::read(fd, buffer, size);
+#endif
+        if (count >= 0) {
+            return static_cast<size_t>(count);
+        }
+        if (errno != EINTR) {
+            throw ioError("Failed to read", name);
+        }
+    }
+}
+
+// 读取到文件末尾；expected 为已知的文件大小（未知时为 0），据此一次分配到位
+std::string readAll(int fd, size_t expected, const std::string& name) {
+    std::string content(expected, '\0');
+    size_t filled = 0;
+    while (filled < expected) {
+        size_t count = readSome(fd, content.data() + filled, expected - filled, name);
+        if (count == 0) {
+            content.resize(filled);
+            return content;
+        }
+        filled += count;
+    }
+
+    // 大小未知（管道）或文件在读取期间变长：继续按块追加直到末尾
+    char chunk[64 * 1024];
+    while (size_t count = readSome(fd, chunk, sizeof(chunk), name)) {
+        content.append(chunk, count);
+    }
+    return content;
+}
+
+} // namespace
+
+SourceFile::SourceFile() : data_(""), size_(0), mapped_(false) {
+}
+
+SourceFile SourceFile::open(const std::string& path) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDONLY | _O_BINARY);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd < 0) {
+        throw ioError("Cannot open file", path);
+    }
+
+    try {
+        SourceFile file = fromDescriptor(fd, path);
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+        return file;
+    } catch (...) {
+#ifdef _WIN32
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+        throw;
+    }
+}
+
+SourceFile SourceFile::fromDescriptor(int fd, const std::string& name) {
+    SourceFile file;
+    size_t expected = 0;
+
+#ifndef _WIN32
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        expected = static_cast<size_t>(info.st_size);
+        // 大小为 0 的常规文件不映射：procfs、sysfs 及部分 FUSE 文件报告大小为 0 却仍有内容，照常读取
+        void* address = expected != 0 ? ::mmap(nullptr, expected, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        if (address != MAP_FAILED) {
+            // 词法分析是一次顺序扫描，提示内核积极预读
+            ::madvise(address, expected, MADV_SEQUENTIAL);
+            file.data_ = static_cast<const char*>(address);
+            file.size_ = expected;
+            file.mapped_ = true;
+            return file;
+        }
+    }
+#else
+    struct _stat64 info {};
+    if (_fstat64(fd, &info) == 0 && (info.st_mode & _S_IFREG) != 0) {
+        expected = static_cast<size_t>(info.st_size);
+    }
+#endif
+
+    // 无法映射（管道、终端等）：一次性批量读取
+    file.buffer_ = readAll(fd, expected, name);
+    file.data_ = file.buffer_.data();
+    file.size_ = file.buffer_.size();
+    return file;
+}
+
+SourceFile::SourceFile(SourceFile&& other) noexcept
+    : data_(other.data_), size_(other.size_), mapped_(other.mapped_), buffer_(std::move(other.buffer_)) {
+    if (!mapped_) {
+        data_ = buffer_.data();
+    }
+    other.data_ = "";
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+SourceFile& SourceFile::operator=(SourceFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+        if (!mapped_) {
+            data_ = buffer_.data();
+        }
+        other.data_ = "";
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+    return *this;
+}
+
+SourceFile::~SourceFile() {
+    release();
+}
+
+void SourceFile::release() {
+#ifndef _WIN32
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+    data_ = "";
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+} // namespace dreamlang::lexer
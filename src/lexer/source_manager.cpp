@@ -0,0 +1,119 @@
+#include "lexer/source_manager.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace dreamlang::lexer {
+
+SourceManager::SourceManager() : next_base_(1) {
+}
+
+FileId SourceManager::addFile(std::string name, SourceFile&& file) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    // 先确认地址空间足够，失败时 file 保持不变
+    uint32_t base = nextBase(file.size());
+    auto entry = std::make_unique<Entry>();
+    entry->name = std::move(name);
+    entry->file.emplace(std::move(file));
+    entry->buffer = entry->file->view();
+    entry->base = base;
+    return insert(std::move(entry));
+}
+
+FileId SourceManager::addBuffer(std::string name, std::string contents) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    uint32_t base = nextBase(contents.size());
+    auto entry = std::make_unique<Entry>();
+    entry->name = std::move(name);
+    entry->contents = std::move(contents);
+    entry->buffer = entry->contents;
+    entry->base = base;
+    return insert(std::move(entry));
+}
+
+uint32_t SourceManager::nextBase(size_t size) const {
+    // 文件末尾也要有自己的位置，因此每个文件占用 大小 + 1 个位置
+    if (next_base_ + size + 1 > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("SourceManager address space exhausted (limit is 4 GiB)");
+    }
+    return static_cast<uint32_t>(next_base_);
+}
+
+FileId SourceManager::insert(std::unique_ptr<Entry> entry) {
+    bases_.push_back(entry->base);
+    next_base_ = static_cast<uint64_t>(entry->base) + entry->buffer.size() + 1;
+    entries_.push_back(std::move(entry));
+    return static_cast<FileId>(entries_.size());
+}
+
+const SourceManager::Entry& SourceManager::entry(FileId file) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (file == 0 || file > entries_.size()) {
+        throw std::out_of_range("Invalid FileId");
+    }
+    return *entries_[file - 1];
+}
+
+std::string_view SourceManager::getBuffer(FileId file) const {
+    return entry(file).buffer;
+}
+
+const std::string& SourceManager::getFileName(FileId file) const {
+    return entry(file).name;
+}
+
+SourceLocation SourceManager::getLocation(FileId file, size_t offset) const {
+    const Entry& found = entry(file);
+    if (offset > found.buffer.size()) {
+        throw std::out_of_range("Offset is outside of the file");
+    }
+    return SourceLocation::fromRawEncoding(found.base + static_cast<uint32_t>(offset));
+}
+
+FileId SourceManager::getFileId(SourceLocation location) const {
+    if (!location.isValid()) {
+        return 0;
+    }
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    // 最后一个起点不大于该位置的文件
+    auto it = std::upper_bound(bases_.begin(), bases_.end(), location.getRawEncoding());
+    if (it == bases_.begin()) {
+        return 0;
+    }
+    size_t index = it - bases_.begin() - 1;
+    if (location.getRawEncoding() - bases_[index] > entries_[index]->buffer.size()) {
+        return 0;
+    }
+    return static_cast<FileId>(index + 1);
+}
+
+size_t SourceManager::getFileOffset(SourceLocation location) const {
+    FileId file = getFileId(location);
+    return file != 0 ? location.getRawEncoding() - entry(file).base : 0;
+}
+
+SourcePosition SourceManager::getPosition(SourceLocation location) const {
+    FileId file = getFileId(location);
+    if (file == 0) {
+        return {0, 0};
+    }
+    const Entry& found = entry(file);
+    std::call_once(found.line_index_once, [&found]() { found.line_index.emplace(found.buffer); });
+    return found.line_index->resolve(location.getRawEncoding() - found.base);
+}
+
+std::string SourceManager::formatLocation(SourceLocation location) const {
+    FileId file = getFileId(location);
+    if (file == 0) {
+        return {};
+    }
+    SourcePosition position = getPosition(location);
+    return entry(file).name + ":" + std::to_string(position.line) + ":" + std::to_string(position.column);
+}
+
+size_t SourceManager::getFileCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,133 @@
+#include "lexer/stream_lexer.h"
+#include "lexer/simd_scan.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace dreamlang::lexer {
+
+StreamLexer::StreamLexer(std::istream& input, size_t chunk_size, LexerEngine engine)
+    : input_(&input), fd_(-1), chunk_size_(std::max<size_t>(chunk_size, 1)), engine_(engine), symbols_(nullptr),
+      eof_(false), window_offset_(0), window_line_(1), window_column_(1), token_offset_(0), token_position_{1, 1} {
+}
+
+StreamLexer::StreamLexer(int fd, size_t chunk_size, LexerEngine engine)
+    : input_(nullptr), fd_(fd), chunk_size_(std::max<size_t>(chunk_size, 1)), engine_(engine), symbols_(nullptr),
+      eof_(false), window_offset_(0), window_line_(1), window_column_(1), token_offset_(0), token_position_{1, 1} {
+}
+
+void StreamLexer::setSymbolTable(SymbolTable* symbols) {
+    symbols_ = symbols;
+    if (lexer_) {
+        lexer_->setSymbolTable(symbols);
+    }
+}
+
+Token StreamLexer::nextToken() {
+    if (!lexer_) {
+        refill(0);
+    }
+
+    while (true) {
+        size_t start = lexer_->getOffset();
+        try {
+            Token token = lexer_->nextToken();
+            // Token太靠近窗口末尾时，后续数据可能延长它（或把EOF变成新的Token），
+            // 需要补充数据后重新分析
+            if (!eof_ && lexer_->getOffset() + Lexical::kMaxLookahead >= window_.size()) {
+                refill(start);
+                continue;
+            }
+            token_offset_ = window_offset_ + token.getOffset();
+            token_position_ = toGlobal(token.getPosition(lexer_->getLineIndex()));
+            return token;
+        } catch (const LexicalException& e) {
+            // 未闭合的字符串/注释等错误可能只是因为数据还没读到
+            if (!eof_ && lexer_->getOffset() + Lexical::kMaxLookahead >= window_.size()) {
+                refill(start);
+                continue;
+            }
+            SourcePosition position = toGlobal({e.getLine(), e.getColumn()});
+            throw LexicalException(e.getErrorType(), e.getErrorChar(), e.getErrorTokenType(), position.line,
+                                   position.column);
+        }
+    }
+}
+
+void StreamLexer::refill(size_t consumed) {
+    // 词法分析器借用窗口缓冲区，修改窗口之前先销毁它
+    lexer_.reset();
+
+    // 丢弃已经产出的前缀，同时推进窗口起点的行列号
+    if (consumed > 0) {
+        size_t newlines = simd::countByte(window_.data(), 0, consumed, '\n');
+        if (newlines > 0) {
+            window_line_ += static_cast<int>(newlines);
+            window_column_ = static_cast<int>(consumed - window_.rfind('\n', consumed - 1));
+        } else {
+            window_column_ += static_cast<int>(consumed);
+        }
+        window_offset_ += consumed;
+        window_.erase(0, consumed);
+    }
+
+    // 保留下来的是尚未完成的Token：每次至少读入与它等长的数据，窗口按几何级数增长，
+    // 超长Token（巨大的字符串或块注释）被重复扫描的总量因此与其长度成线性关系
+    size_t kept = window_.size();
+    size_t wanted = std::max(chunk_size_, kept);
+    window_.resize(kept + wanted);
+    size_t count = 0;
+    while (count < wanted) {
+        size_t read = readChunk(window_.data() + kept + count, wanted - count);
+        if (read == 0) {
+            eof_ = true;
+            break;
+        }
+        count += read;
+    }
+    window_.resize(kept + count);
+
+    lexer_.emplace(std::string_view(window_), engine_);
+    lexer_->setSymbolTable(symbols_);
+}
+
+size_t StreamLexer::readChunk(char* buffer, size_t size) {
+    if (input_ != nullptr) {
+        input_->read(buffer, static_cast<std::streamsize>(size));
+        if (input_->bad()) {
+            throw std::runtime_error("Failed to read from input stream");
+        }
+        return static_cast<size_t>(input_->gcount());
+    }
+
+    while (true) {
+#ifdef _WIN32
+        int count = _read(fd_, buffer, static_cast<unsigned int>(std::min<size_t>(size, INT32_MAX)));
+#else
+        ssize_t count = ::read(fd_, buffer, size);
+#endif
+        if (count >= 0) {
+            return static_cast<size_t>(count);
+        }
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("Failed to read from file descriptor: ") + std::strerror(errno));
+        }
+    }
+}
+
+SourcePosition StreamLexer::toGlobal(SourcePosition local) const {
+    if (local.line == 1) {
+        return {window_line_, window_column_ + local.column - 1};
+    }
+    return {window_line_ + local.line - 1, local.column};
+}
+
+} // namespace dreamlang::lexer
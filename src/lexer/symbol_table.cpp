@@ -0,0 +1,121 @@
+#include "lexer/symbol_table.h"
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+
+namespace dreamlang::lexer {
+
+namespace {
+
+// 每个分片的初始槽位数
+constexpr size_t kInitialSlots = 64;
+
+} // namespace
+
+SymbolTable::SymbolTable() {
+    for (auto& shard : shards_) {
+        shard.slots.resize(kInitialSlots);
+    }
+}
+
+uint32_t SymbolTable::hashName(std::string_view name) {
+    // FNV-1a，再做一次混合使高位也足够分散（高位用于选择分片）
+    uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+size_t SymbolTable::probe(const Shard& shard, std::string_view name, uint32_t hash) {
+    size_t mask = shard.slots.size() - 1;
+    for (size_t index = hash & mask;; index = (index + 1) & mask) {
+        const Slot& slot = shard.slots[index];
+        if (slot.data == nullptr ||
+            (slot.hash == hash && slot.length == name.size() && std::memcmp(slot.data, name.data(), name.size()) == 0)) {
+            return index;
+        }
+    }
+}
+
+void SymbolTable::grow(Shard& shard) {
+    std::vector<Slot> old_slots(shard.slots.size() * 2);
+    old_slots.swap(shard.slots);
+    size_t mask = shard.slots.size() - 1;
+    for (const Slot& slot : old_slots) {
+        if (slot.data == nullptr) {
+            continue;
+        }
+        size_t index = slot.hash & mask;
+        while (shard.slots[index].data != nullptr) {
+            index = (index + 1) & mask;
+        }
+        shard.slots[index] = slot;
+    }
+}
+
+SymbolId SymbolTable::intern(std::string_view name) {
+    uint32_t hash = hashName(name);
+    Shard& shard = shards_[hash >> (32 - kShardBits)];
+
+    // 绝大多数调用命中已有名字，只需共享锁
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        const Slot& slot = shard.slots[probe(shard, name, hash)];
+        if (slot.data != nullptr) {
+            return slot.id;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    // 释放共享锁之后其他线程可能已经插入了同一名字
+    Slot& slot = shard.slots[probe(shard, name, hash)];
+    if (slot.data != nullptr) {
+        return slot.id;
+    }
+
+    const std::string& stored = shard.storage.emplace_back(name);
+    SymbolId id;
+    {
+        std::unique_lock<std::shared_mutex> names_lock(names_mutex_);
+        if (names_.size() >= kInvalidSymbol) {
+            shard.storage.pop_back();
+            throw std::length_error("Too many symbols for SymbolTable");
+        }
+        id = static_cast<SymbolId>(names_.size());
+        names_.push_back(stored);
+    }
+
+    slot = {stored.data(), static_cast<uint32_t>(stored.size()), hash, id};
+    // 装载因子保持在 1/2 以下，探测链足够短
+    if (++shard.count * 2 > shard.slots.size()) {
+        grow(shard);
+    }
+    return id;
+}
+
+SymbolId SymbolTable::find(std::string_view name) const {
+    uint32_t hash = hashName(name);
+    const Shard& shard = shards_[hash >> (32 - kShardBits)];
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const Slot& slot = shard.slots[probe(shard, name, hash)];
+    return slot.data != nullptr ? slot.id : kInvalidSymbol;
+}
+
+std::string_view SymbolTable::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(names_mutex_);
+    return names_.at(id);
+}
+
+size_t SymbolTable::size() const {
+    std::shared_lock<std::shared_mutex> lock(names_mutex_);
+    return names_.size();
+}
+
+} // namespace dreamlang::lexer
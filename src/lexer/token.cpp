@@ -3,36 +3,9 @@
 
 namespace dreamlang::lexer {
 
-Token::Token(TokenType type, const std::string& value, int line, int column)
-    : type_(type), value_(value), line_(line), column_(column) {
-}
-
-Token::Token(const Token& other)
-    : type_(other.type_), value_(other.value_), line_(other.line_), column_(other.column_) {
-}
-
-Token::Token(Token&& other) noexcept
-    : type_(other.type_), value_(std::move(other.value_)), line_(other.line_), column_(other.column_) {
-}
-
-Token& Token::operator=(const Token& other) {
-    if (this != &other) {
-        type_ = other.type_;
-        value_ = other.value_;
-        line_ = other.line_;
-        column_ = other.column_;
-    }
-    return *this;
-}
-
-Token& Token::operator=(Token&& other) noexcept {
-    if (this != &other) {
-        type_ = other.type_;
-        value_ = std::move(other.value_);
-        line_ = other.line_;
-        column_ = other.column_;
-    }
-    return *this;
+Token::Token(TokenType type, std::string_view value, uint32_t offset, uint32_t length, uint64_t payload,
+             uint8_t flags)
+    : value_(value), payload_(payload), offset_(offset), length_(length), type_(type), flags_(flags) {
 }
 
 bool Token::isOperator() const {
@@ -77,16 +50,29 @@ std::string Token::toString() const {
     std::ostringstream oss;
     oss << "Token{type=" << tokenTypeToString(type_) 
         << ", value=\"" << value_ << "\""
-        << ", line=" << line_ 
-        << ", column=" << column_ << "}";
+        << ", offset=" << offset_ 
+        << ", length=" << length_ << "}";
+    return oss.str();
+}
+
+std::string Token::toString(const LineIndex& line_index) const {
+    return toString(getPosition(line_index));
+}
+
+std::string Token::toString(const SourcePosition& position) const {
+    std::ostringstream oss;
+    oss << "Token{type=" << tokenTypeToString(type_) 
+        << ", value=\"" << value_ << "\""
+        << ", line=" << position.line 
+        << ", column=" << position.column << "}";
     return oss.str();
 }
 
 bool Token::operator==(const Token& other) const {
     return type_ == other.type_ && 
            value_ == other.value_ && 
-           line_ == other.line_ && 
-           column_ == other.column_;
+           offset_ == other.offset_ && 
+           length_ == other.length_;
 }
 
 bool Token::operator!=(const Token& other) const {
@@ -0,0 +1,261 @@
+#include "lexer/token_buffer.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace dreamlang::lexer {
+
+static_assert(static_cast<int>(TokenType::EOF_TOKEN) <= std::numeric_limits<uint8_t>::max(),
+              "TokenType must fit in one byte");
+
+namespace {
+
+// 把 values[first, first + removed) 替换为 replacement 的全部元素
+template <typename T>
+void spliceVector(std::pmr::vector<T>& values, size_t first, size_t removed,
+                  const std::pmr::vector<T>& replacement) {
+    size_t common = std::min(removed, replacement.size());
+    std::copy(replacement.begin(), replacement.begin() + common, values.begin() + first);
+    if (removed > common) {
+        values.erase(values.begin() + first + common, values.begin() + first + removed);
+    } else {
+        values.insert(values.begin() + first + common, replacement.begin() + common, replacement.end());
+    }
+}
+
+} // namespace
+
+TokenBuffer::TokenBuffer(std::string_view source, std::pmr::memory_resource* resource)
+    : source_(source), kinds_(resource), offsets_(resource), lengths_(resource), payload_indices_(resource),
+      payloads_(resource), flags_(resource), decoded_indices_(resource), decoded_values_(resource),
+      decoded_arena_(util::Arena::kDefaultBlockSize, resource) {
+    if (source_.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Source too large for TokenBuffer (limit is 4 GiB)");
+    }
+}
+
+void TokenBuffer::push(TokenType type, size_t offset, size_t length, std::string_view value, uint64_t payload,
+                       uint8_t flags) {
+    auto off = static_cast<uint32_t>(offset);
+    auto len = static_cast<uint32_t>(length);
+
+    // 只有字符串/字符字面量的值可能经过转义解码，其他Token的值总是等于源码切片
+    std::string_view natural = sourceValue(type, off, len);
+    bool is_literal = type == TokenType::STRING || type == TokenType::CHAR;
+    if (is_literal && (value.data() != natural.data() || value.size() != natural.size())) {
+        decoded_indices_.push_back(static_cast<uint32_t>(kinds_.size()));
+        decoded_values_.push_back(decoded_arena_.copy(value));
+    }
+
+    if (payload != defaultPayload(type) || flags != 0) {
+        payload_indices_.push_back(static_cast<uint32_t>(kinds_.size()));
+        payloads_.push_back(payload);
+        flags_.push_back(flags);
+    }
+
+    kinds_.push_back(static_cast<uint8_t>(type));
+    offsets_.push_back(off);
+    lengths_.push_back(len);
+}
+
+void TokenBuffer::append(const TokenBuffer& other, size_t first) {
+    if (first >= other.size()) {
+        return;
+    }
+    size_t base = kinds_.size();
+
+    kinds_.insert(kinds_.end(), other.kinds_.begin() + first, other.kinds_.end());
+    offsets_.insert(offsets_.end(), other.offsets_.begin() + first, other.offsets_.end());
+    lengths_.insert(lengths_.end(), other.lengths_.begin() + first, other.lengths_.end());
+
+    auto payload_it = std::lower_bound(other.payload_indices_.begin(), other.payload_indices_.end(), first);
+    size_t payload_first = payload_it - other.payload_indices_.begin();
+    for (; payload_it != other.payload_indices_.end(); ++payload_it) {
+        payload_indices_.push_back(static_cast<uint32_t>(base + (*payload_it - first)));
+    }
+    payloads_.insert(payloads_.end(), other.payloads_.begin() + payload_first, other.payloads_.end());
+    flags_.insert(flags_.end(), other.flags_.begin() + payload_first, other.flags_.end());
+
+    auto it = std::lower_bound(other.decoded_indices_.begin(), other.decoded_indices_.end(), first);
+    for (; it != other.decoded_indices_.end(); ++it) {
+        decoded_indices_.push_back(static_cast<uint32_t>(base + (*it - first)));
+        decoded_values_.push_back(decoded_arena_.copy(other.decoded_values_[it - other.decoded_indices_.begin()]));
+    }
+}
+
+void TokenBuffer::replaceRange(size_t first, size_t last, const TokenBuffer& replacement,
+                               std::string_view new_source, size_t edit_offset, size_t old_length,
+                               size_t new_length) {
+    if (new_source.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Source too large for TokenBuffer (limit is 4 GiB)");
+    }
+
+    size_t removed = last - first;
+    size_t added = replacement.size();
+    auto delta = static_cast<uint32_t>(new_length - old_length);
+
+    // 未被替换的尾部整体平移（无符号回绕即可表示负的平移量）
+    for (size_t i = last; i < offsets_.size(); ++i) {
+        offsets_[i] += delta;
+    }
+
+    spliceVector(kinds_, first, removed, replacement.kinds_);
+    spliceVector(offsets_, first, removed, replacement.offsets_);
+    spliceVector(lengths_, first, removed, replacement.lengths_);
+
+    // 附表：删除区间内的，平移区间后的下标，再插入替换进来的
+    auto payload_begin = std::lower_bound(payload_indices_.begin(), payload_indices_.end(), first);
+    auto payload_end = std::lower_bound(payload_begin, payload_indices_.end(), last);
+    size_t payload_position = payload_begin - payload_indices_.begin();
+    size_t payload_erased = payload_end - payload_begin;
+    for (auto it = payload_end; it != payload_indices_.end(); ++it) {
+        *it = static_cast<uint32_t>(*it - removed + added);
+    }
+    payload_indices_.erase(payload_begin, payload_end);
+    payloads_.erase(payloads_.begin() + payload_position, payloads_.begin() + payload_position + payload_erased);
+    flags_.erase(flags_.begin() + payload_position, flags_.begin() + payload_position + payload_erased);
+    std::vector<uint32_t> payload_indices;
+    payload_indices.reserve(replacement.payload_indices_.size());
+    for (uint32_t index : replacement.payload_indices_) {
+        payload_indices.push_back(static_cast<uint32_t>(first + index));
+    }
+    payload_indices_.insert(payload_indices_.begin() + payload_position, payload_indices.begin(),
+                            payload_indices.end());
+    payloads_.insert(payloads_.begin() + payload_position, replacement.payloads_.begin(),
+                     replacement.payloads_.end());
+    flags_.insert(flags_.begin() + payload_position, replacement.flags_.begin(), replacement.flags_.end());
+
+    // 解码值：删除区间内的，平移区间后的下标，再插入替换进来的
+    auto begin = std::lower_bound(decoded_indices_.begin(), decoded_indices_.end(), first);
+    auto end = std::lower_bound(begin, decoded_indices_.end(), last);
+    size_t position = begin - decoded_indices_.begin();
+    size_t erased = end - begin;
+    for (auto it = end; it != decoded_indices_.end(); ++it) {
+        *it = static_cast<uint32_t>(*it - removed + added);
+    }
+    decoded_indices_.erase(begin, end);
+    decoded_values_.erase(decoded_values_.begin() + position, decoded_values_.begin() + position + erased);
+
+    // 被替换掉的解码值留在竞技场中，直到缓冲区清空或销毁
+    if (!replacement.decoded_indices_.empty()) {
+        std::vector<uint32_t> indices;
+        std::vector<std::string_view> values;
+        indices.reserve(replacement.decoded_indices_.size());
+        values.reserve(replacement.decoded_values_.size());
+        for (size_t i = 0; i < replacement.decoded_indices_.size(); ++i) {
+            indices.push_back(static_cast<uint32_t>(first + replacement.decoded_indices_[i]));
+            values.push_back(decoded_arena_.copy(replacement.decoded_values_[i]));
+        }
+        decoded_indices_.insert(decoded_indices_.begin() + position, indices.begin(), indices.end());
+        decoded_values_.insert(decoded_values_.begin() + position, values.begin(), values.end());
+    }
+
+    source_ = new_source;
+    if (line_index_) {
+        line_index_->applyEdit(new_source, edit_offset, old_length, new_length);
+    }
+}
+
+void TokenBuffer::reserve(size_t count) {
+    kinds_.reserve(count);
+    offsets_.reserve(count);
+    lengths_.reserve(count);
+}
+
+void TokenBuffer::clear() {
+    kinds_.clear();
+    offsets_.clear();
+    lengths_.clear();
+    payload_indices_.clear();
+    payloads_.clear();
+    flags_.clear();
+    decoded_indices_.clear();
+    decoded_values_.clear();
+    decoded_arena_.reset();
+}
+
+void TokenBuffer::reset(std::string_view source) {
+    if (source.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Source too large for TokenBuffer (limit is 4 GiB)");
+    }
+    clear();
+    source_ = source;
+    line_index_.reset();
+}
+
+std::string_view TokenBuffer::value(size_t index) const {
+    TokenType token_type = type(index);
+
+    if (token_type == TokenType::STRING || token_type == TokenType::CHAR) {
+        auto it = std::lower_bound(decoded_indices_.begin(), decoded_indices_.end(), index);
+        if (it != decoded_indices_.end() && *it == index) {
+            return decoded_values_[it - decoded_indices_.begin()];
+        }
+    }
+
+    return sourceValue(token_type, offsets_[index], lengths_[index]);
+}
+
+size_t TokenBuffer::findPayload(size_t index) const {
+    auto it = std::lower_bound(payload_indices_.begin(), payload_indices_.end(), index);
+    if (it != payload_indices_.end() && *it == index) {
+        return it - payload_indices_.begin();
+    }
+    return payload_indices_.size();
+}
+
+NumberLiteral TokenBuffer::number(size_t index) const {
+    size_t position = findPayload(index);
+    if (position == payload_indices_.size()) {
+        return NumberLiteral::fromPayload(0, 0);
+    }
+    return NumberLiteral::fromPayload(payloads_[position], flags_[position]);
+}
+
+SymbolId TokenBuffer::symbol(size_t index) const {
+    size_t position = findPayload(index);
+    if (position == payload_indices_.size()) {
+        return static_cast<SymbolId>(defaultPayload(type(index)));
+    }
+    return static_cast<SymbolId>(payloads_[position]);
+}
+
+int TokenBuffer::line(size_t index) const {
+    return lineIndex().lineOf(offsets_[index] + lengths_[index]);
+}
+
+int TokenBuffer::column(size_t index) const {
+    return lineIndex().resolve(offsets_[index] + lengths_[index]).column;
+}
+
+Token TokenBuffer::operator[](size_t index) const {
+    TokenType token_type = type(index);
+    uint64_t payload = defaultPayload(token_type);
+    uint8_t flags = 0;
+    // 只有数字和标识符可能带有附加值
+    if (token_type == TokenType::NUMBER || token_type == TokenType::IDENT) {
+        size_t position = findPayload(index);
+        if (position != payload_indices_.size()) {
+            payload = payloads_[position];
+            flags = flags_[position];
+        }
+    }
+    return {token_type, value(index), offsets_[index], lengths_[index], payload, flags};
+}
+
+const LineIndex& TokenBuffer::lineIndex() const {
+    if (!line_index_) {
+        line_index_.emplace(source_);
+    }
+    return *line_index_;
+}
+
+std::string_view TokenBuffer::sourceValue(TokenType type, uint32_t offset, uint32_t length) const {
+    if ((type == TokenType::STRING || type == TokenType::CHAR) && length >= 2) {
+        // 去掉两侧引号
+        return source_.substr(offset + 1, length - 2);
+    }
+    return source_.substr(offset, length);
+}
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,355 @@
+#include "lexer/token_cache.h"
+#include "lexer/lexical.h"
+#include "lexer/source_file.h"
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace dreamlang::lexer {
+
+namespace {
+
+// 缓存文件的布局版本（与词法规则版本分开，布局变化时递增）
+constexpr uint32_t kFormatVersion = 2;
+constexpr char kMagic[4] = {'D', 'L', 'T', 'C'};
+
+// 缓存文件头，之后依次是：附加值、偏移、长度、解码值下标、解码值长度、附加值下标（各为定长
+// 数组）、类型、标志位，最后是解码值的字节。附表只保存数字的附加值，符号编号在读取时重新驻留
+struct CacheHeader {
+    char magic[4];
+    // 以本机字节序写入，字节序不同的机器读到的版本号不符，按未命中处理
+    uint32_t format;
+    uint32_t rules;
+    uint32_t token_count;
+    uint64_t source_size;
+    uint64_t content_hash;
+    uint32_t decoded_count;
+    uint32_t payload_count;
+    uint64_t decoded_bytes;
+};
+
+static_assert(sizeof(CacheHeader) == 48, "CacheHeader must have a stable layout");
+
+// 缓存文件的期望大小
+uint64_t entrySize(const CacheHeader& header) {
+    uint64_t tokens = header.token_count;
+    uint64_t decoded = header.decoded_count;
+    uint64_t payloads = header.payload_count;
+    return sizeof(CacheHeader) + tokens * (2 * sizeof(uint32_t) + sizeof(uint8_t)) +
+           payloads * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t)) + decoded * 2 * sizeof(uint32_t) +
+           header.decoded_bytes;
+}
+
+// 从映射中按顺序读取定长数组的游标
+struct Reader {
+    const char* cursor;
+
+    template <typename T>
+    void read(T* target, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        std::memcpy(target, cursor, count * sizeof(T));
+        cursor += count * sizeof(T);
+    }
+};
+
+template <typename T>
+void writeArray(std::ofstream& file, const T* data, size_t count) {
+    file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+// ---------------------------------------------------------------------------
+// XXH64
+// ---------------------------------------------------------------------------
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+inline uint64_t read64(const char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t read32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t round64(uint64_t accumulator, uint64_t input) {
+    accumulator += input * kPrime2;
+    return rotl(accumulator, 31) * kPrime1;
+}
+
+inline uint64_t mergeRound(uint64_t hash, uint64_t accumulator) {
+    hash ^= round64(0, accumulator);
+    return hash * kPrime1 + kPrime4;
+}
+
+} // namespace
+
+TokenCache::TokenCache(std::string directory) : directory_(std::move(directory)) {
+}
+
+uint64_t TokenCache::hashContent(std::string_view content) {
+    const char* p = content.data();
+    const char* end = p + content.size();
+    uint64_t hash;
+
+    if (content.size() >= 32) {
+        // 四路独立累加，每次处理 32 字节
+        uint64_t v1 = kPrime1 + kPrime2;
+        uint64_t v2 = kPrime2;
+        uint64_t v3 = 0;
+        uint64_t v4 = 0 - kPrime1;
+        for (; p + 32 <= end; p += 32) {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+        }
+        hash = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = kPrime5;
+    }
+
+    hash += content.size();
+    for (; p + 8 <= end; p += 8) {
+        hash ^= round64(0, read64(p));
+        hash = rotl(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (p + 4 <= end) {
+        hash ^= static_cast<uint64_t>(read32(p)) * kPrime1;
+        hash = rotl(hash, 23) * kPrime2 + kPrime3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        hash ^= static_cast<uint64_t>(static_cast<unsigned char>(*p)) * kPrime5;
+        hash = rotl(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+std::string TokenCache::entryPath(uint64_t hash) const {
+    // 文件名同时包含内容哈希和词法规则版本，不同版本的程序可以共用一个缓存目录
+    char name[48];
+    std::snprintf(name, sizeof(name), "%016llx-%u.tok", static_cast<unsigned long long>(hash),
+                  static_cast<unsigned>(Lexical::kRulesVersion));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+std::optional<TokenBuffer> TokenCache::load(std::string_view source, SymbolTable* symbols,
+                                            std::pmr::memory_resource* resource) const {
+    uint64_t hash = hashContent(source);
+    std::string path = entryPath(hash);
+
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) {
+        return std::nullopt;
+    }
+
+    try {
+        SourceFile entry = SourceFile::open(path);
+        std::string_view data = entry.view();
+
+        CacheHeader header{};
+        if (data.size() < sizeof(header)) {
+            return std::nullopt;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.format != kFormatVersion ||
+            header.rules != Lexical::kRulesVersion || header.source_size != source.size() ||
+            header.content_hash != hash || header.decoded_count > header.token_count ||
+            header.payload_count > header.token_count ||
+            header.decoded_bytes > data.size() || entrySize(header) != data.size()) {
+            return std::nullopt;
+        }
+
+        size_t count = header.token_count;
+        size_t decoded_count = header.decoded_count;
+        size_t payload_count = header.payload_count;
+        TokenBuffer tokens(source, resource);
+        tokens.kinds_.resize(count);
+        tokens.offsets_.resize(count);
+        tokens.lengths_.resize(count);
+        tokens.decoded_indices_.resize(decoded_count);
+        std::pmr::vector<uint32_t> decoded_lengths(decoded_count, resource);
+        std::pmr::vector<uint32_t> payload_indices(payload_count, resource);
+        std::pmr::vector<uint64_t> payloads(payload_count, resource);
+        std::pmr::vector<uint8_t> flags(payload_count, resource);
+
+        Reader reader{data.data() + sizeof(header)};
+        reader.read(payloads.data(), payload_count);
+        reader.read(tokens.offsets_.data(), count);
+        reader.read(tokens.lengths_.data(), count);
+        reader.read(tokens.decoded_indices_.data(), decoded_count);
+        reader.read(decoded_lengths.data(), decoded_count);
+        reader.read(payload_indices.data(), payload_count);
+        reader.read(tokens.kinds_.data(), count);
+        reader.read(flags.data(), payload_count);
+
+        // 校验每个Token都落在源码范围内，损坏的缓存不能产生越界的视图
+        for (size_t i = 0; i < count; ++i) {
+            if (tokens.kinds_[i] > static_cast<uint8_t>(TokenType::EOF_TOKEN) ||
+                static_cast<uint64_t>(tokens.offsets_[i]) + tokens.lengths_[i] > source.size()) {
+                return std::nullopt;
+            }
+        }
+        for (size_t i = 0; i < payload_count; ++i) {
+            if (payload_indices[i] >= count || (i > 0 && payload_indices[i] <= payload_indices[i - 1])) {
+                return std::nullopt;
+            }
+        }
+
+        uint64_t decoded_total = 0;
+        tokens.decoded_values_.reserve(decoded_count);
+        for (size_t i = 0; i < decoded_count; ++i) {
+            uint32_t index = tokens.decoded_indices_[i];
+            decoded_total += decoded_lengths[i];
+            if (index >= count || (i > 0 && index <= tokens.decoded_indices_[i - 1]) ||
+                decoded_total > header.decoded_bytes) {
+                return std::nullopt;
+            }
+            // 映射在返回前解除，解码值复制到缓冲区自己的存储中
+            tokens.decoded_values_.push_back(tokens.decoded_arena_.copy({reader.cursor, decoded_lengths[i]}));
+            reader.cursor += decoded_lengths[i];
+        }
+
+        // 符号编号只在本次运行的符号表内有意义，按需重新驻留并与数字的附加值按下标合并
+        if (symbols == nullptr) {
+            tokens.payload_indices_ = std::move(payload_indices);
+            tokens.payloads_ = std::move(payloads);
+            tokens.flags_ = std::move(flags);
+            return tokens;
+        }
+        size_t next = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (next < payload_count && payload_indices[next] == i) {
+                tokens.payload_indices_.push_back(payload_indices[next]);
+                tokens.payloads_.push_back(payloads[next]);
+                tokens.flags_.push_back(flags[next]);
+                ++next;
+            } else if (static_cast<TokenType>(tokens.kinds_[i]) == TokenType::IDENT) {
+                tokens.payload_indices_.push_back(static_cast<uint32_t>(i));
+                tokens.payloads_.push_back(symbols->intern(tokens.value(i)));
+                tokens.flags_.push_back(0);
+            }
+        }
+        return tokens;
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+bool TokenCache::store(std::string_view source, const TokenBuffer& tokens) const {
+    static std::atomic<unsigned> sequence{0};
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format = kFormatVersion;
+    header.rules = Lexical::kRulesVersion;
+    header.token_count = static_cast<uint32_t>(tokens.size());
+    header.source_size = source.size();
+    header.content_hash = hashContent(source);
+    header.decoded_count = static_cast<uint32_t>(tokens.decoded_values_.size());
+
+    // 符号编号不写入缓存，附表中只保留数字的附加值
+    std::vector<uint32_t> payload_indices;
+    std::vector<uint64_t> payloads;
+    std::vector<uint8_t> flags;
+    for (size_t i = 0; i < tokens.payload_indices_.size(); ++i) {
+        if (tokens.type(tokens.payload_indices_[i]) != TokenType::IDENT) {
+            payload_indices.push_back(tokens.payload_indices_[i]);
+            payloads.push_back(tokens.payloads_[i]);
+            flags.push_back(tokens.flags_[i]);
+        }
+    }
+    header.payload_count = static_cast<uint32_t>(payload_indices.size());
+
+    std::vector<uint32_t> decoded_lengths;
+    decoded_lengths.reserve(tokens.decoded_values_.size());
+    for (std::string_view value : tokens.decoded_values_) {
+        decoded_lengths.push_back(static_cast<uint32_t>(value.size()));
+        header.decoded_bytes += value.size();
+    }
+
+    std::string path = entryPath(header.content_hash);
+    // 先写入本进程、本线程唯一的临时文件，写完再改名，读者不会看到写了一半的文件
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(::getpid());
+#endif
+    std::string temporary = path + "." + std::to_string(pid) + "." + std::to_string(sequence++) + ".tmp";
+
+    try {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+            size_t count = tokens.size();
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            writeArray(file, payloads.data(), payloads.size());
+            writeArray(file, tokens.offsets_.data(), count);
+            writeArray(file, tokens.lengths_.data(), count);
+            writeArray(file, tokens.decoded_indices_.data(), tokens.decoded_indices_.size());
+            writeArray(file, decoded_lengths.data(), decoded_lengths.size());
+            writeArray(file, payload_indices.data(), payload_indices.size());
+            writeArray(file, tokens.kinds_.data(), count);
+            writeArray(file, flags.data(), flags.size());
+            for (std::string_view value : tokens.decoded_values_) {
+                file.write(value.data(), static_cast<std::streamsize>(value.size()));
+            }
+            if (!file.flush()) {
+                file.close();
+                std::filesystem::remove(temporary, error);
+                return false;
+            }
+        }
+
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            return false;
+        }
+        return true;
+    } catch (const std::exception&) {
+        std::error_code error;
+        std::filesystem::remove(temporary, error);
+        return false;
+    }
+}
+
+} // namespace dreamlang::lexer
@@ -0,0 +1,73 @@
+#include "lexer/token_cursor.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace dreamlang::lexer {
+
+namespace {
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+TokenCursor::TokenCursor(Lexical& lexer, size_t capacity)
+    : lexer_(lexer), ring_(roundUpToPowerOfTwo(capacity), Token(TokenType::EOF_TOKEN, {}, 0, 0)),
+      mask_(ring_.size() - 1), begin_(0), end_(0), position_(0) {
+}
+
+const Token& TokenCursor::peek(size_t n) {
+    if (n >= ring_.size()) {
+        throw std::out_of_range("TokenCursor lookahead exceeds buffer capacity");
+    }
+    fill(position_ + n);
+    return ring_[(position_ + n) & mask_];
+}
+
+Token TokenCursor::advance() {
+    fill(position_);
+    Token token = ring_[position_ & mask_];
+    if (token.getType() != TokenType::EOF_TOKEN) {
+        ++position_;
+    }
+    return token;
+}
+
+TokenCursor::Mark TokenCursor::mark() const {
+    if (position_ < end_) {
+        return {position_, ring_[position_ & mask_].getOffset()};
+    }
+    // 当前Token尚未分析：词法分析器正停在它前面
+    return {position_, lexer_.getOffset()};
+}
+
+void TokenCursor::rewind(const Mark& checkpoint) {
+    if (checkpoint.index >= begin_ && checkpoint.index <= end_) {
+        position_ = checkpoint.index;
+        return;
+    }
+    // 检查点已移出缓冲区：从其起点重新分析
+    lexer_.seek(checkpoint.offset);
+    begin_ = end_ = position_ = checkpoint.index;
+}
+
+void TokenCursor::fill(size_t index) {
+    while (end_ <= index) {
+        // 已到达EOF时不再调用词法分析器，直接重复EOF Token
+        if (end_ > begin_ && ring_[(end_ - 1) & mask_].getType() == TokenType::EOF_TOKEN) {
+            ring_[end_ & mask_] = ring_[(end_ - 1) & mask_];
+        } else {
+            ring_[end_ & mask_] = lexer_.nextToken();
+        }
+        ++end_;
+        // 覆盖最旧的Token（peek 的范围保证不会覆盖当前位置）
+        begin_ = std::max(begin_, end_ - std::min(end_, ring_.size()));
+    }
+}
+
+} // namespace dreamlang::lexer
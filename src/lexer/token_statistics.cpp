@@ -0,0 +1,33 @@
+#include "lexer/token_statistics.h"
+
+namespace dreamlang::lexer {
+
+size_t countTokens(std::string_view source, LexerEngine engine, SymbolTable* symbols,
+                   SourceLocation file_start) {
+    StatisticsLexical lexer(source, engine);
+    lexer.setSymbolTable(symbols);
+    lexer.setFileLocation(file_start);
+    size_t total = 1;
+    while (lexer.nextToken().getType() != TokenType::EOF_TOKEN) {
+        ++total;
+    }
+    return total;
+}
+
+TokenStatistics collectTokenStatistics(std::string_view source, LexerEngine engine, SymbolTable* symbols,
+                                       SourceLocation file_start) {
+    StatisticsLexical lexer(source, engine);
+    lexer.setSymbolTable(symbols);
+    lexer.setFileLocation(file_start);
+    TokenStatistics statistics;
+    while (true) {
+        TokenType type = lexer.nextToken().getType();
+        ++statistics.by_type[static_cast<size_t>(type)];
+        ++statistics.total;
+        if (type == TokenType::EOF_TOKEN) {
+            return statistics;
+        }
+    }
+}
+
+} // namespace dreamlang::lexer
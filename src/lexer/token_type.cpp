@@ -13,7 +13,37 @@ const char* tokenTypeToString(TokenType type) {
         case TokenType::CHAR: return "CHAR";
         case TokenType::SINGLE_COMMENT: return "SINGLE_COMMENT";
         case TokenType::MULTI_COMMENT: return "MULTI_COMMENT";
-        case TokenType::KEYWORD: return "KEYWORD";
+        case TokenType::KW_BOOL: return "KW_BOOL";
+        case TokenType::KW_NUMBER: return "KW_NUMBER";
+        case TokenType::KW_CHAR: return "KW_CHAR";
+        case TokenType::KW_STRING: return "KW_STRING";
+        case TokenType::KW_FUNCTION: return "KW_FUNCTION";
+        case TokenType::KW_ARRAY: return "KW_ARRAY";
+        case TokenType::KW_CLASS: return "KW_CLASS";
+        case TokenType::KW_OBJECT: return "KW_OBJECT";
+        case TokenType::KW_REFERENCE: return "KW_REFERENCE";
+        case TokenType::KW_PACKAGE: return "KW_PACKAGE";
+        case TokenType::KW_IMPORT: return "KW_IMPORT";
+        case TokenType::KW_VAR: return "KW_VAR";
+        case TokenType::KW_VAL: return "KW_VAL";
+        case TokenType::KW_REF: return "KW_REF";
+        case TokenType::KW_RETURN: return "KW_RETURN";
+        case TokenType::KW_FUN: return "KW_FUN";
+        case TokenType::KW_IF: return "KW_IF";
+        case TokenType::KW_ELSE: return "KW_ELSE";
+        case TokenType::KW_FOR: return "KW_FOR";
+        case TokenType::KW_WHILE: return "KW_WHILE";
+        case TokenType::KW_BREAK: return "KW_BREAK";
+        case TokenType::KW_CONTINUE: return "KW_CONTINUE";
+        case TokenType::KW_SWITCH: return "KW_SWITCH";
+        case TokenType::KW_CASE: return "KW_CASE";
+        case TokenType::KW_DEFAULT: return "KW_DEFAULT";
+        case TokenType::KW_SUPER: return "KW_SUPER";
+        case TokenType::KW_THIS: return "KW_THIS";
+        case TokenType::KW_AVAILABLE: return "KW_AVAILABLE";
+        case TokenType::KW_IN: return "KW_IN";
+        case TokenType::KW_INTERFACE: return "KW_INTERFACE";
+        case TokenType::KW_ABSTRACT: return "KW_ABSTRACT";
         case TokenType::ASSIGN: return "ASSIGN";
         case TokenType::PLUS: return "PLUS";
         case TokenType::MINUS: return "MINUS";
@@ -41,6 +71,7 @@ const char* tokenTypeToString(TokenType type) {
         case TokenType::RIGHT_BRACKET: return "RIGHT_BRACKET";
         case TokenType::LEFT_BRACE: return "LEFT_BRACE";
         case TokenType::RIGHT_BRACE: return "RIGHT_BRACE";
+        case TokenType::ERROR: return "ERROR";
         case TokenType::EOF_TOKEN: return "EOF";
         default: return "UNKNOWN";
     }
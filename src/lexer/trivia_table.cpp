@@ -0,0 +1,23 @@
+#include "lexer/trivia_table.h"
+#include <algorithm>
+
+namespace dreamlang::lexer {
+
+TriviaTable::TriviaTable(std::string_view source, std::pmr::memory_resource* resource)
+    : source_(source), kinds_(resource), offsets_(resource), lengths_(resource), token_indices_(resource) {
+}
+
+void TriviaTable::clear() {
+    kinds_.clear();
+    offsets_.clear();
+    lengths_.clear();
+    token_indices_.clear();
+}
+
+std::pair<size_t, size_t> TriviaTable::leading(size_t token_index) const {
+    auto range = std::equal_range(token_indices_.begin(), token_indices_.end(), static_cast<uint32_t>(token_index));
+    return {static_cast<size_t>(range.first - token_indices_.begin()),
+            static_cast<size_t>(range.second - token_indices_.begin())};
+}
+
+} // namespace dreamlang::lexer
@@ -1,4 +1,12 @@
 #include "lexer/lexical.h"
+#include "lexer/stream_lexer.h"
+#include "lexer/source_file.h"
+#include "lexer/source_manager.h"
+#include "lexer/parallel_lexer.h"
+#include "lexer/token_cache.h"
+#include "lexer/token_statistics.h"
+#include "util/thread_pool.h"
+#include "util/arena.h"
 #include "lexer/lexical_exception.h"
 #include "i18n/locale_manager.h"
 #include "config/config_manager.h"
@@ -7,6 +15,12 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <filesystem>
+#include <future>
+#include <sstream>
+#include <memory_resource>
+#include <optional>
+#include <thread>
 
 void printUsage(const char* program_name) {
     using namespace dreamlang::i18n;
@@ -14,7 +28,8 @@ void printUsage(const char* program_name) {
     
     std::cout << locale_mgr.gettext("Usage") << ": " << program_name 
               << " [" << locale_mgr.gettext("options") << "] [<" 
-              << locale_mgr.gettext("source_file") << ".zv>]" << std::endl;
+              << locale_mgr.gettext("source_file") << ".zv|" << locale_mgr.gettext("directory") << "|@" 
+              << locale_mgr.gettext("file_list") << ">...]" << std::endl;
     std::cout << std::endl;
     std::cout << locale_mgr.gettext("Options") << ":" << std::endl;
     std::cout << "  -h, --help     " << locale_mgr.gettext("Show this help message") << std::endl;
@@ -22,6 +37,11 @@ void printUsage(const char* program_name) {
     std::cout << "  -l, --locale   " << locale_mgr.gettext("Set locale (e.g., zh_CN, en_US)") << std::endl;
     std::cout << "  -t, --tokens   " << locale_mgr.gettext("Show tokenization result") << std::endl;
     std::cout << "  -c, --config   " << locale_mgr.gettext("Set default config or specify config file") << std::endl;
+    std::cout << "  -e, --engine   " << locale_mgr.gettext("Select lexer engine (classic, table)") << std::endl;
+    std::cout << "  -j, --jobs     " << locale_mgr.gettext("Number of lexer threads (0 = all cores)") << std::endl;
+    std::cout << "  -s, --stream   " << locale_mgr.gettext("Read the source file in chunks with bounded memory") << std::endl;
+    std::cout << "  -r, --recover  " << locale_mgr.gettext("Report all lexical errors instead of stopping at the first") << std::endl;
+    std::cout << "  -k, --cache    " << locale_mgr.gettext("Reuse token streams cached on disk for unchanged files") << std::endl;
     std::cout << std::endl;
     std::cout << locale_mgr.gettext("Note") << ": " 
               << locale_mgr.gettext("If source file has no extension, .zv will be automatically appended.") << std::endl;
@@ -57,56 +77,391 @@ std::string resolveSourceFile(const std::string& filename) {
     return filename;
 }
 
-std::string readFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
+dreamlang::lexer::SourceFile loadSourceFile(const std::string& filename) {
+    try {
+        return dreamlang::lexer::SourceFile::open(filename);
+    } catch (const std::runtime_error&) {
         using namespace dreamlang::i18n;
         auto& locale_mgr = LocaleManager::getInstance();
         throw std::runtime_error(locale_mgr.gettext("Cannot open file") + ": " + filename);
     }
+}
+
+// 单个文件分析会话的竞技场块大小：典型源文件的Token缓冲区只需一两次系统分配
+constexpr size_t kSessionBlockSize = 1 << 20;
+
+/**
+ * 单个源文件的分析选项
+ */
+struct LexOptions {
+    bool show_tokens = false;
+    bool stream = false;
+    bool recover = false;
+    size_t chunk_size = dreamlang::lexer::StreamLexer::kDefaultChunkSize;
+    unsigned jobs = 1;
+    dreamlang::lexer::LexerEngine engine = dreamlang::lexer::LexerEngine::CLASSIC;
+    // 驻留标识符的符号表（批量模式下所有文件共享），为空时不驻留
+    dreamlang::lexer::SymbolTable* symbols = nullptr;
+    // 磁盘Token缓存，为空时不使用（流式和恢复模式下也不使用）
+    const dreamlang::lexer::TokenCache* cache = nullptr;
+};
+
+/**
+ * 单个源文件的分析结果
+ */
+struct LexResult {
+    size_t token_count = 0;
+    // 恢复模式下报告的词法错误数
+    size_t error_count = 0;
+};
+
+/**
+ * 输出分析成功的汇总
+ */
+void printTokenCount(size_t token_count, std::ostream& out) {
+    using namespace dreamlang::i18n;
     
-    std::string content;
-    std::string line;
-    while (std::getline(file, line)) {
-        content += line + "\n";
-    }
+    auto& locale_mgr = LocaleManager::getInstance();
+    out << locale_mgr.gettext("Lexical analysis completed successfully") 
+        << ". " << locale_mgr.gettext("Found") << " " << token_count 
+        << " " << locale_mgr.gettext("tokens") << "." << std::endl;
+}
+
+/**
+ * 输出一条词法错误
+ *
+ * 错误位置能通过源码管理器解码时以 "文件名:行:列: " 开头，否则（如流式分析）以文件名开头。
+ */
+void printLexicalError(const dreamlang::lexer::LexicalException& error,
+                       const dreamlang::lexer::SourceManager& sources, const std::string& filename,
+                       std::ostream& err) {
+    using namespace dreamlang::i18n;
     
-    return content;
+    auto& locale_mgr = LocaleManager::getInstance();
+    std::string location = sources.formatLocation(error.getLocation());
+    err << (location.empty() ? filename : location) << ": " 
+        << locale_mgr.gettext("Lexical Error") << ": " << error.getLocalizedMessage() << std::endl;
 }
 
-void tokenizeAndPrint(const std::string& source_code, bool show_tokens = false) {
+/**
+ * 输出Token结果（show_tokens 为假时只输出汇总）
+ */
+void printTokenBuffer(const dreamlang::lexer::TokenBuffer& tokens, std::ostream& out, bool show_tokens) {
     using namespace dreamlang::lexer;
     using namespace dreamlang::i18n;
     
     auto& locale_mgr = LocaleManager::getInstance();
     
-    try {
-        Lexical lexer(source_code);
-        std::vector<Token> tokens = lexer.tokenize();
+    if (show_tokens) {
+        out << locale_mgr.gettext("Tokenization result") << ":" << std::endl;
+        out << "===========================================" << std::endl;
         
-        if (show_tokens) {
-            std::cout << locale_mgr.gettext("Tokenization result") << ":" << std::endl;
-            std::cout << "===========================================" << std::endl;
-            
-            for (const auto& token : tokens) {
-                if (token.getType() != TokenType::LINEBREAK) {
-                    std::cout << token.toString() << std::endl;
-                }
+        for (const auto& token : tokens) {
+            if (token.getType() != TokenType::LINEBREAK) {
+                out << token.toString(tokens.lineIndex()) << std::endl;
             }
-            
-            std::cout << "===========================================" << std::endl;
-            std::cout << locale_mgr.gettext("Total tokens") << ": " << tokens.size() << std::endl;
-        } else {
-            std::cout << locale_mgr.gettext("Lexical analysis completed successfully") 
-                      << ". " << locale_mgr.gettext("Found") << " " << tokens.size() 
-                      << " " << locale_mgr.gettext("tokens") << "." << std::endl;
         }
         
-    } catch (const LexicalException& e) {
-        std::cerr << locale_mgr.gettext("Lexical Error") << ": " 
-                  << e.getLocalizedMessage() << std::endl;
-        exit(1);
+        out << "===========================================" << std::endl;
+        out << locale_mgr.gettext("Total tokens") << ": " << tokens.size() << std::endl;
+    } else {
+        printTokenCount(tokens.size(), out);
+    }
+}
+
+/**
+ * 分析一段源码并输出结果
+ * @param file_start 源码在 SourceManager 中的起点（可为无效位置）
+ * @return Token数量
+ */
+size_t tokenizeAndPrint(std::string_view source_code, const LexOptions& options, std::ostream& out,
+                        std::pmr::memory_resource* resource = nullptr,
+                        dreamlang::lexer::SourceLocation file_start = {}) {
+    using namespace dreamlang::lexer;
+    
+    if (resource == nullptr) {
+        resource = std::pmr::get_default_resource();
+    }
+    
+    // 内容未变的文件直接使用缓存的结果
+    if (options.cache != nullptr) {
+        if (std::optional<TokenBuffer> cached = options.cache->load(source_code, options.symbols, resource)) {
+            printTokenBuffer(*cached, out, options.show_tokens);
+            return cached->size();
+        }
+    }
+    
+    ParallelOptions parallel;
+    parallel.threads = options.jobs;
+    parallel.engine = options.engine;
+    parallel.symbols = options.symbols;
+    parallel.resource = resource;
+    parallel.file_start = file_start;
+    
+    // 只输出汇总时直接计数，不构建Token缓冲区；需要写入缓存或能拆分并行分析时仍走完整路径
+    unsigned threads = options.jobs != 0 ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+    if (!options.show_tokens && options.cache == nullptr &&
+        (threads <= 1 || source_code.size() / parallel.min_chunk_size <= 1)) {
+        size_t token_count = countTokens(source_code, options.engine, options.symbols, file_start);
+        printTokenCount(token_count, out);
+        return token_count;
+    }
+    
+    TokenBuffer tokens = tokenizeParallel(source_code, parallel);
+    if (options.cache != nullptr) {
+        options.cache->store(source_code, tokens);
+    }
+    printTokenBuffer(tokens, out, options.show_tokens);
+    return tokens.size();
+}
+
+/**
+ * 以错误恢复模式分析源码管理器中的一个文件：诊断写入 err，Token结果照常写入 out
+ * @return Token数量与诊断数量
+ */
+LexResult tokenizeRecoveringAndPrint(const dreamlang::lexer::SourceManager& sources, dreamlang::lexer::FileId file,
+                                     const LexOptions& options, std::ostream& out, std::ostream& err,
+                                     std::pmr::memory_resource* resource = nullptr) {
+    using namespace dreamlang::lexer;
+    using namespace dreamlang::i18n;
+    
+    auto& locale_mgr = LocaleManager::getInstance();
+    
+    // 恢复模式需要诊断按源码顺序产生，因此不拆分并行分析
+    Lexical lexer(sources.getBuffer(file), options.engine);
+    lexer.setErrorRecovery(true);
+    lexer.setSymbolTable(options.symbols);
+    lexer.setFileLocation(sources.getLocation(file));
+    if (resource != nullptr) {
+        lexer.setMemoryResource(resource);
+    }
+    TokenBuffer tokens = lexer.tokenize();
+    
+    const auto& diagnostics = lexer.getDiagnostics();
+    for (const auto& diagnostic : diagnostics) {
+        printLexicalError(diagnostic.toException(tokens.lineIndex()), sources, sources.getFileName(file), err);
+    }
+    
+    if (diagnostics.empty() || options.show_tokens) {
+        // 错误片段以 ERROR Token 的形式出现在结果中
+        printTokenBuffer(tokens, out, options.show_tokens);
+    } else {
+        out << locale_mgr.gettext("Lexical analysis completed with errors") 
+            << ". " << locale_mgr.gettext("Found") << " " << tokens.size() 
+            << " " << locale_mgr.gettext("tokens") << ", " << locale_mgr.gettext("Errors") << ": " 
+            << diagnostics.size() << "." << std::endl;
+    }
+    
+    return {tokens.size(), diagnostics.size()};
+}
+
+size_t tokenizeStreamAndPrint(const std::string& filename, const LexOptions& options, std::ostream& out) {
+    using namespace dreamlang::lexer;
+    using namespace dreamlang::i18n;
+    
+    auto& locale_mgr = LocaleManager::getInstance();
+    
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error(locale_mgr.gettext("Cannot open file") + ": " + filename);
+    }
+    
+    StreamLexer lexer(file, options.chunk_size, options.engine);
+    lexer.setSymbolTable(options.symbols);
+    size_t token_count = 0;
+    
+    if (options.show_tokens) {
+        out << locale_mgr.gettext("Tokenization result") << ":" << std::endl;
+        out << "===========================================" << std::endl;
+    }
+    
+    while (true) {
+        Token token = lexer.nextToken();
+        ++token_count;
+        if (options.show_tokens && token.getType() != TokenType::LINEBREAK) {
+            out << token.toString(lexer.getTokenPosition()) << std::endl;
+        }
+        if (token.getType() == TokenType::EOF_TOKEN) {
+            break;
+        }
+    }
+    
+    if (options.show_tokens) {
+        out << "===========================================" << std::endl;
+        out << locale_mgr.gettext("Total tokens") << ": " << token_count << std::endl;
+    } else {
+        printTokenCount(token_count, out);
+    }
+    
+    return token_count;
+}
+
+/**
+ * 分析一个源文件并把结果写入 out，恢复模式下的诊断写入 err
+ *
+ * 源码加载到 sources 中（流式分析除外），词法错误的 SourceLocation 由它解码。sources 由
+ * 调用方按文件创建，输出该文件的错误之后即可销毁，因此批量模式不会累积所有文件的源码。
+ * @return Token数量与诊断数量
+ * @throws LexicalException 词法错误（非恢复模式）
+ * @throws std::runtime_error 无法读取文件，或文件超出 SourceLocation 的编址范围
+ */
+LexResult processSourceFile(const std::string& filename, const LexOptions& options,
+                            dreamlang::lexer::SourceManager& sources, std::ostream& out, std::ostream& err) {
+    if (options.stream) {
+        return {tokenizeStreamAndPrint(filename, options, out), 0};
+    }
+    dreamlang::lexer::FileId file;
+    try {
+        file = sources.addFile(filename, loadSourceFile(filename));
+    } catch (const std::length_error&) {
+        // Token缓冲区同样只有 32 位偏移，这样的文件只能流式分析
+        using namespace dreamlang::i18n;
+        auto& locale_mgr = LocaleManager::getInstance();
+        throw std::runtime_error(locale_mgr.gettext("File is too large, use --stream") + ": " + filename);
+    }
+    // 本文件的分析会话：Token缓冲区与解码的字面量都从这里分配，函数返回时一次释放
+    dreamlang::util::Arena session(kSessionBlockSize);
+    if (options.recover) {
+        return tokenizeRecoveringAndPrint(sources, file, options, out, err, &session);
+    }
+    return {tokenizeAndPrint(sources.getBuffer(file), options, out, &session, sources.getLocation(file)), 0};
+}
+
+/**
+ * 把命令行输入展开为源文件列表
+ *
+ * 目录递归收集其中的 .zv 文件（按路径排序），@文件 每行列出一个输入（忽略空行和
+ * # 开头的注释行），其他参数按单个源文件处理。
+ * @param expanding 正在展开的文件列表（规范路径），用于发现列表直接或间接包含自身
+ * @throws std::runtime_error 文件列表无法打开或循环包含
+ */
+void collectSourceFiles(const std::string& input, std::vector<std::string>& files,
+                        std::vector<std::string>& expanding) {
+    namespace fs = std::filesystem;
+    
+    if (input.size() > 1 && input[0] == '@') {
+        using namespace dreamlang::i18n;
+        auto& locale_mgr = LocaleManager::getInstance();
+        std::string list_path = input.substr(1);
+        std::ifstream list(list_path);
+        if (!list.is_open()) {
+            throw std::runtime_error(locale_mgr.gettext("Cannot open file list") + ": " + list_path);
+        }
+        std::error_code canonical_error;
+        std::string canonical = fs::weakly_canonical(list_path, canonical_error).string();
+        if (canonical_error) {
+            canonical = list_path;
+        }
+        if (std::find(expanding.begin(), expanding.end(), canonical) != expanding.end()) {
+            throw std::runtime_error(locale_mgr.gettext("File list includes itself") + ": " + list_path);
+        }
+        expanding.push_back(canonical);
+        std::string line;
+        while (std::getline(list, line)) {
+            size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            size_t last = line.find_last_not_of(" \t\r");
+            collectSourceFiles(line.substr(first, last - first + 1), files, expanding);
+        }
+        expanding.pop_back();
+        return;
+    }
+    
+    std::error_code error;
+    if (fs::is_directory(input, error)) {
+        std::vector<std::string> found;
+        for (fs::recursive_directory_iterator it(input, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error) && it->path().extension() == ".zv") {
+                found.push_back(it->path().string());
+            }
+        }
+        std::sort(found.begin(), found.end());
+        files.insert(files.end(), found.begin(), found.end());
+        return;
+    }
+    
+    files.push_back(resolveSourceFile(input));
+}
+
+/**
+ * 批量模式：在线程池中分析所有文件，按输入顺序输出每个文件的结果和汇总
+ * @return 进程退出码
+ */
+int runBatch(const std::vector<std::string>& files, const LexOptions& options, size_t jobs) {
+    using namespace dreamlang::i18n;
+    auto& locale_mgr = LocaleManager::getInstance();
+    
+    // 单个文件的分析结果
+    struct FileReport {
+        std::string output;
+        // 词法错误输出（每行一条，已带有位置）
+        std::string diagnostics;
+        // 其他错误（如无法读取文件）
+        std::string error;
+        bool failed = false;
+        size_t token_count = 0;
+    };
+    
+    // 文件之间已经并行，单个文件内部不再拆分；所有文件共享一张符号表
+    dreamlang::lexer::SymbolTable symbols;
+    LexOptions file_options = options;
+    file_options.jobs = 1;
+    file_options.symbols = &symbols;
+    
+    dreamlang::util::ThreadPool pool(jobs);
+    std::vector<std::future<FileReport>> reports;
+    reports.reserve(files.size());
+    for (const auto& file : files) {
+        reports.push_back(pool.submit([&file, &file_options]() {
+            FileReport report;
+            std::ostringstream out;
+            std::ostringstream err;
+            // 本文件的源码，生成报告之后随之释放
+            dreamlang::lexer::SourceManager sources;
+            try {
+                LexResult result = processSourceFile(file, file_options, sources, out, err);
+                report.token_count = result.token_count;
+                report.failed = result.error_count > 0;
+                report.output = out.str();
+            } catch (const dreamlang::lexer::LexicalException& e) {
+                printLexicalError(e, sources, file, err);
+                report.failed = true;
+            } catch (const std::exception& e) {
+                report.error = e.what();
+                report.failed = true;
+            }
+            report.diagnostics = err.str();
+            return report;
+        }));
+    }
+    
+    // 按输入顺序取结果，已完成的文件立即输出并释放
+    size_t total_tokens = 0;
+    size_t failed_files = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        FileReport report = reports[i].get();
+        if (!report.output.empty()) {
+            std::cout << files[i] << ": " << report.output << std::flush;
+        }
+        total_tokens += report.token_count;
+        std::cerr << report.diagnostics;
+        if (!report.error.empty()) {
+            std::cerr << files[i] << ": " << locale_mgr.gettext("Error") << ": " << report.error << std::endl;
+        }
+        if (report.failed) {
+            ++failed_files;
+        }
     }
+    
+    std::cout << "===========================================" << std::endl;
+    std::cout << locale_mgr.gettext("Files") << ": " << files.size() << ", " 
+              << locale_mgr.gettext("Total tokens") << ": " << total_tokens << ", " 
+              << locale_mgr.gettext("Identifiers") << ": " << symbols.size() << ", " 
+              << locale_mgr.gettext("Errors") << ": " << failed_files << std::endl;
+    
+    return failed_files == 0 ? 0 : 1;
 }
 
 int main(int argc, char* argv[]) {
@@ -164,12 +519,17 @@ int main(int argc, char* argv[]) {
     }
     
     // 解析命令行参数
-    std::string source_file;
+    std::vector<std::string> source_inputs;
     std::string custom_locale;
     std::string custom_config;
+    std::string engine_name;
+    std::string jobs_arg;
     bool show_help = false;
     bool show_version = false;
     bool show_tokens = false;
+    bool stream_mode = false;
+    bool recover_mode = false;
+    bool cache_mode = false;
     
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
@@ -180,6 +540,20 @@ int main(int argc, char* argv[]) {
             show_version = true;
         } else if (arg == "-t" || arg == "--tokens") {
             show_tokens = true;
+        } else if (arg == "-j" || arg == "--jobs") {
+            if (i + 1 < argc) {
+                jobs_arg = argv[++i];
+            } else {
+                std::cerr << locale_mgr.gettext("Error") << ": " 
+                          << locale_mgr.gettext("Option --jobs requires an argument") << std::endl;
+                return 1;
+            }
+        } else if (arg == "-s" || arg == "--stream") {
+            stream_mode = true;
+        } else if (arg == "-r" || arg == "--recover") {
+            recover_mode = true;
+        } else if (arg == "-k" || arg == "--cache") {
+            cache_mode = true;
         } else if (arg == "-c" || arg == "--config") {
             if (i + 1 < argc) {
                 custom_config = argv[++i];
@@ -188,6 +562,14 @@ int main(int argc, char* argv[]) {
                           << locale_mgr.gettext("Option --config requires an argument") << std::endl;
                 return 1;
             }
+        } else if (arg == "-e" || arg == "--engine") {
+            if (i + 1 < argc) {
+                engine_name = argv[++i];
+            } else {
+                std::cerr << locale_mgr.gettext("Error") << ": " 
+                          << locale_mgr.gettext("Option --engine requires an argument") << std::endl;
+                return 1;
+            }
         } else if (arg == "-l" || arg == "--locale") {
             if (i + 1 < argc) {
                 custom_locale = argv[++i];
@@ -202,20 +584,14 @@ int main(int argc, char* argv[]) {
             printUsage(argv[0]);
             return 1;
         } else {
-            if (source_file.empty()) {
-                source_file = arg;
-            } else {
-                std::cerr << locale_mgr.gettext("Error") << ": " 
-                          << locale_mgr.gettext("Multiple source files specified") << std::endl;
-                return 1;
-            }
+            source_inputs.push_back(arg);
         }
     }
     
     // 如果指定了自定义配置文件，重新加载配置
     if (!custom_config.empty()) {
         // 检查是否只指定了配置文件而没有源文件（设置默认配置模式）
-        if (source_file.empty() && !show_help && !show_version) {
+        if (source_inputs.empty() && !show_help && !show_version) {
             // 设置默认配置模式
             if (config_mgr.setAsDefaultConfig(custom_config)) {
                 std::cout << locale_mgr.gettext("Default config set successfully") << ": " 
@@ -263,17 +639,105 @@ int main(int argc, char* argv[]) {
         return 0;
     }
     
-    if (source_file.empty()) {
+    if (source_inputs.empty()) {
         std::cerr << locale_mgr.gettext("Error") << ": " 
                   << locale_mgr.gettext("No source file specified") << std::endl;
         printUsage(argv[0]);
         return 1;
     }
     
+    // 选择词法分析引擎（命令行参数优先于配置文件）
+    if (engine_name.empty()) {
+        engine_name = config_mgr.getString("lexer.engine", "classic");
+    }
+    dreamlang::lexer::LexerEngine engine;
+    if (!dreamlang::lexer::parseLexerEngine(engine_name, engine)) {
+        std::cerr << locale_mgr.gettext("Error") << ": " 
+                  << locale_mgr.gettext("Unknown lexer engine") << " '" << engine_name << "'" << std::endl;
+        return 1;
+    }
+    
+    // 线程数（命令行参数优先于配置文件，0 表示使用全部核心）
+    int jobs = config_mgr.getInt("lexer.jobs", 0);
+    if (jobs_arg.empty()) {
+        // 报错时显示实际被拒绝的值
+        jobs_arg = std::to_string(jobs);
+    } else {
+        try {
+            size_t parsed = 0;
+            jobs = std::stoi(jobs_arg, &parsed);
+            if (parsed != jobs_arg.size()) {
+                jobs = -1;
+            }
+        } catch (const std::exception&) {
+            jobs = -1;
+        }
+    }
+    if (jobs < 0) {
+        std::cerr << locale_mgr.gettext("Error") << ": " 
+                  << locale_mgr.gettext("Invalid number of jobs") << " '" << jobs_arg << "'" << std::endl;
+        return 1;
+    }
+    
+    // 错误恢复模式（命令行参数或配置文件开启）
+    recover_mode = recover_mode || config_mgr.getBool("lexer.error_recovery", false);
+    if (recover_mode && stream_mode) {
+        std::cerr << locale_mgr.gettext("Error") << ": " 
+                  << locale_mgr.gettext("Options --stream and --recover cannot be used together") << std::endl;
+        return 1;
+    }
+    
+    LexOptions options;
+    options.show_tokens = show_tokens;
+    options.stream = stream_mode;
+    options.recover = recover_mode;
+    options.engine = engine;
+    options.jobs = static_cast<unsigned>(jobs);
+    int chunk_size = config_mgr.getInt("lexer.stream_chunk_size",
+                                       static_cast<int>(dreamlang::lexer::StreamLexer::kDefaultChunkSize));
+    if (chunk_size > 0) {
+        options.chunk_size = static_cast<size_t>(chunk_size);
+    }
+    
+    // 磁盘Token缓存（命令行参数或配置文件开启），默认目录在 .config 配置目录下
+    std::optional<dreamlang::lexer::TokenCache> token_cache;
+    if (cache_mode || config_mgr.getBool("lexer.token_cache", false)) {
+        std::string cache_dir = config_mgr.getString("lexer.token_cache_dir", "");
+        if (cache_dir.empty()) {
+            cache_dir = ConfigManager::getDefaultConfigDir(program_path) + "/token_cache";
+        }
+        token_cache.emplace(cache_dir);
+        options.cache = &*token_cache;
+    }
+    
+    std::vector<std::string> source_files;
+    try {
+        for (const auto& input : source_inputs) {
+            std::vector<std::string> expanding;
+            collectSourceFiles(input, source_files, expanding);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << locale_mgr.gettext("Error") << ": " << e.what() << std::endl;
+        return 1;
+    }
+    
+    // 多个文件、目录或文件列表进入批量模式
+    std::error_code fs_error;
+    bool batch_mode = source_inputs.size() > 1 || source_inputs[0][0] == '@' || 
+                      std::filesystem::is_directory(source_inputs[0], fs_error);
+    if (batch_mode) {
+        return runBatch(source_files, options, static_cast<size_t>(jobs));
+    }
+    
+    dreamlang::lexer::SourceManager sources;
     try {
-        std::string resolved_file = resolveSourceFile(source_file);
-        std::string source_code = readFile(resolved_file);
-        tokenizeAndPrint(source_code, show_tokens);
+        LexResult result = processSourceFile(source_files[0], options, sources, std::cout, std::cerr);
+        if (result.error_count > 0) {
+            return 1;
+        }
+    } catch (const dreamlang::lexer::LexicalException& e) {
+        printLexicalError(e, sources, source_files[0], std::cerr);
+        return 1;
     } catch (const std::exception& e) {
         std::cerr << locale_mgr.gettext("Error") << ": " << e.what() << std::endl;
         return 1;
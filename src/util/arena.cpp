@@ -0,0 +1,153 @@
+#include "util/arena.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace dreamlang::util {
+
+Arena::Arena(size_t block_size, std::pmr::memory_resource* upstream)
+    : block_size_(std::max<size_t>(block_size, 64)), upstream_(upstream), cursor_(nullptr), end_(nullptr),
+      capacity_(0), block_allocations_(0) {
+}
+
+Arena::Arena(Arena&& other) noexcept
+    : block_size_(other.block_size_), upstream_(other.upstream_), blocks_(std::move(other.blocks_)),
+      cursor_(other.cursor_), end_(other.end_), capacity_(other.capacity_),
+      block_allocations_(other.block_allocations_) {
+    other.blocks_.clear();
+    other.cursor_ = nullptr;
+    other.end_ = nullptr;
+    other.capacity_ = 0;
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        releaseBlocks();
+        block_size_ = other.block_size_;
+        upstream_ = other.upstream_;
+        blocks_ = std::move(other.blocks_);
+        cursor_ = std::exchange(other.cursor_, nullptr);
+        end_ = std::exchange(other.end_, nullptr);
+        capacity_ = std::exchange(other.capacity_, 0);
+        block_allocations_ = other.block_allocations_;
+        other.blocks_.clear();
+    }
+    return *this;
+}
+
+Arena::~Arena() {
+    releaseBlocks();
+}
+
+char* Arena::allocate(size_t size) {
+    if (static_cast<size_t>(end_ - cursor_) >= size) {
+        char* result = cursor_;
+        cursor_ += size;
+        return result;
+    }
+
+    // 大块单独分配，当前块的剩余空间留给之后的小分配
+    if (size > block_size_ / 2) {
+        return newBlock(size);
+    }
+
+    cursor_ = newBlock(block_size_);
+    end_ = cursor_ + block_size_;
+    char* result = cursor_;
+    cursor_ += size;
+    return result;
+}
+
+void Arena::shrink(char* data, size_t old_size, size_t new_size) {
+    if (data + old_size == cursor_ && new_size <= old_size) {
+        cursor_ = data + new_size;
+    }
+}
+
+std::string_view Arena::copy(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+    char* data = allocate(text.size());
+    std::memcpy(data, text.data(), text.size());
+    return {data, text.size()};
+}
+
+void Arena::reset() {
+    if (blocks_.empty()) {
+        return;
+    }
+    // 保留最后申请的普通块（大块不保留），其余全部释放
+    auto kept = std::find_if(blocks_.rbegin(), blocks_.rend(), [this](const Block& block) {
+        return block.size == block_size_ && block.alignment == alignof(std::max_align_t);
+    });
+    if (kept == blocks_.rend()) {
+        releaseBlocks();
+        cursor_ = end_ = nullptr;
+        capacity_ = 0;
+        return;
+    }
+    Block block = *kept;
+    kept->data = nullptr;
+    releaseBlocks();
+    cursor_ = block.data;
+    end_ = cursor_ + block.size;
+    capacity_ = block.size;
+    blocks_.push_back(block);
+}
+
+void* Arena::do_allocate(size_t bytes, size_t alignment) {
+    bytes = std::max<size_t>(bytes, 1);
+
+    void* aligned = cursor_;
+    auto space = static_cast<size_t>(end_ - cursor_);
+    if (cursor_ != nullptr && std::align(alignment, bytes, aligned, space) != nullptr) {
+        cursor_ = static_cast<char*>(aligned) + bytes;
+        return aligned;
+    }
+
+    // 块本身按 max_align_t 对齐，更严格的对齐要求同大块一样单独分配
+    if (bytes > block_size_ / 2 || alignment > alignof(std::max_align_t)) {
+        return newBlock(bytes, std::max(alignment, alignof(std::max_align_t)));
+    }
+
+    cursor_ = newBlock(block_size_);
+    end_ = cursor_ + block_size_;
+    void* result = cursor_;
+    cursor_ += bytes;
+    return result;
+}
+
+void Arena::do_deallocate(void* /*p*/, size_t /*bytes*/, size_t /*alignment*/) {
+    // 单调分配：内存随竞技场一起释放
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+char* Arena::newBlock(size_t size, size_t alignment) {
+    // 上游资源不清零内存
+    auto* data = static_cast<char*>(upstream_->allocate(size, alignment));
+    try {
+        blocks_.push_back({data, size, alignment});
+    } catch (...) {
+        upstream_->deallocate(data, size, alignment);
+        throw;
+    }
+    capacity_ += size;
+    ++block_allocations_;
+    return data;
+}
+
+void Arena::releaseBlocks() {
+    for (const Block& block : blocks_) {
+        if (block.data != nullptr) {
+            upstream_->deallocate(block.data, block.size, block.alignment);
+        }
+    }
+    blocks_.clear();
+}
+
+} // namespace dreamlang::util
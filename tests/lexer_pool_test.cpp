@@ -0,0 +1,50 @@
+#include "test_support.h"
+#include "lexer/lexer_pool.h"
+#include <thread>
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+/**
+ * 多个线程同时租用同一个池：结果与独立的 Lexical 相同，租约内修改的设置在归还后恢复
+ */
+DL_TEST(lexer_pool) {
+    LexerPool pool(LexerEngine::CLASSIC, 2);
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < 4; ++thread) {
+        workers.emplace_back([&pool, thread]() {
+            std::mt19937 rng(thread);
+            for (unsigned round = 0; round < 200; ++round) {
+                setContext("thread=" + std::to_string(thread) + " round=" + std::to_string(round));
+                std::string source = randomSource(rng, std::uniform_int_distribution<size_t>(0, 30)(rng));
+                std::string broken = source + "@";
+
+                {
+                    auto lease = pool.acquire(source);
+                    Lexical reference{std::string_view(source)};
+                    DL_CHECK_SAME_TOKENS(lease.tokenize(), reference.tokenize());
+                }
+                {
+                    auto lease = pool.acquire(broken);
+                    lease->setErrorRecovery(true);
+                    lease.tokenize();
+                    DL_CHECK(!lease->getDiagnostics().empty());
+                }
+                {
+                    // 上一个租约打开的恢复模式不能泄漏给下一个租约
+                    auto lease = pool.acquire(broken);
+                    bool threw = false;
+                    try {
+                        lease.tokenize();
+                    } catch (const LexicalException&) {
+                        threw = true;
+                    }
+                    DL_CHECK(threw);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
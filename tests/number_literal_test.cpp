@@ -0,0 +1,43 @@
+#include "test_support.h"
+#include "lexer/number_literal.h"
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+/**
+ * 超出范围与丢失精度分别标记，且标志位经过压缩形式后保持不变
+ */
+DL_TEST(number_literal_flags) {
+    struct Case {
+        const char* text;
+        bool out_of_range;
+        bool inexact;
+    };
+    const Case cases[] = {
+        {"42", false, false},
+        {"3.14", false, false},
+        {"0.1", false, false},
+        {"2.5e-3", false, false},
+        {"1_000.000_1", false, false},
+        {"9007199254740992.0", false, false},
+        {"1.7976931348623157e308", false, false},
+        {"5e-324", false, false},
+        {"9007199254740993.0", false, true},
+        {"123456789012345678901234567890.0", false, true},
+        {"0.3000000000000000444", false, true},
+        {"1e400", true, false},
+        {"1e-400", true, false},
+        {"123456789012345678901234567890", true, false},
+    };
+    for (const Case& c : cases) {
+        setContext(c.text);
+        NumberLiteral literal = parseNumberLiteral(c.text);
+        DL_CHECK(literal.out_of_range == c.out_of_range);
+        DL_CHECK(literal.inexact == c.inexact);
+
+        NumberLiteral restored = NumberLiteral::fromPayload(literal.payload(), literal.flags());
+        DL_CHECK(restored.out_of_range == c.out_of_range);
+        DL_CHECK(restored.inexact == c.inexact);
+        DL_CHECK(restored.payload() == literal.payload());
+    }
+}
@@ -0,0 +1,61 @@
+#include "test_support.h"
+#include "lexer/parallel_lexer.h"
+#include <optional>
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+/**
+ * 用很小的分块并行分析随机源码（长字符串和注释经常跨越分块边界）：Token、附加值、
+ * 符号编号、驻留的名字数量以及第一个词法错误都与 Lexical::tokenize 相同
+ */
+DL_TEST(parallel_lexer) {
+    for (LexerEngine engine : {LexerEngine::CLASSIC, LexerEngine::TABLE}) {
+        for (unsigned round = 0; round < 300; ++round) {
+            unsigned seed = round * 2 + static_cast<unsigned>(engine);
+            std::mt19937 rng(seed);
+            bool allow_errors = round % 4 == 0;
+            std::string source = randomSource(rng, std::uniform_int_distribution<size_t>(0, 80)(rng), allow_errors);
+
+            ParallelOptions options;
+            options.threads = std::uniform_int_distribution<unsigned>(2, 7)(rng);
+            options.min_chunk_size = std::uniform_int_distribution<size_t>(8, 64)(rng);
+            options.engine = engine;
+            setContext("seed=" + std::to_string(seed) + " threads=" + std::to_string(options.threads) +
+                       " min_chunk_size=" + std::to_string(options.min_chunk_size));
+
+            // 两边各用一张新的符号表，编号必须按相同的顺序分配
+            SymbolTable sequential_symbols;
+            std::optional<TokenBuffer> expected;
+            std::optional<LexicalException> expected_error;
+            try {
+                Lexical lexer(std::string_view(source), engine);
+                lexer.setSymbolTable(&sequential_symbols);
+                expected.emplace(lexer.tokenize());
+            } catch (const LexicalException& e) {
+                expected_error.emplace(e);
+            }
+
+            SymbolTable parallel_symbols;
+            options.symbols = &parallel_symbols;
+            std::optional<TokenBuffer> actual;
+            std::optional<LexicalException> actual_error;
+            try {
+                actual.emplace(tokenizeParallel(source, options));
+            } catch (const LexicalException& e) {
+                actual_error.emplace(e);
+            }
+
+            DL_CHECK(expected.has_value() == actual.has_value());
+            if (expected_error) {
+                DL_CHECK(actual_error->getLine() == expected_error->getLine());
+                DL_CHECK(actual_error->getColumn() == expected_error->getColumn());
+                DL_CHECK(actual_error->getErrorType() == expected_error->getErrorType());
+                DL_CHECK(actual_error->getErrorChar() == expected_error->getErrorChar());
+                continue;
+            }
+            DL_CHECK_SAME_TOKENS(*actual, *expected);
+            DL_CHECK(parallel_symbols.size() == sequential_symbols.size());
+        }
+    }
+}
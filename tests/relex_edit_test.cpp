@@ -0,0 +1,88 @@
+#include "test_support.h"
+#include "lexer/incremental_lexer.h"
+#include <algorithm>
+#include <memory>
+#include <optional>
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+namespace {
+
+// 编辑时插入的单个字符：多为能改变相邻Token边界的引号、注释符和数字
+const char kEditChars[] = " \n\"'/*.x1e_";
+
+} // namespace
+
+/**
+ * 随机编辑后 relexEdit 的结果与重新完整分析相同；编辑后有词法错误时抛出异常且Token不变
+ */
+DL_TEST(relex_edit) {
+    for (LexerEngine engine : {LexerEngine::CLASSIC, LexerEngine::TABLE}) {
+        for (unsigned round = 0; round < 150; ++round) {
+            unsigned seed = round * 2 + static_cast<unsigned>(engine);
+            std::mt19937 rng(seed);
+            SymbolTable symbols;
+
+            // Token序列引用每个版本的源码，所有版本都保留到本轮结束
+            std::vector<std::unique_ptr<std::string>> versions;
+            versions.push_back(std::make_unique<std::string>(
+                randomSource(rng, std::uniform_int_distribution<size_t>(0, 40)(rng))));
+            Lexical initial(std::string_view(*versions.back()), engine);
+            initial.setSymbolTable(&symbols);
+            TokenBuffer tokens = initial.tokenize();
+
+            for (unsigned step = 0; step < 25; ++step) {
+                const std::string& old_source = *versions.back();
+                size_t offset = std::uniform_int_distribution<size_t>(0, old_source.size())(rng);
+                size_t old_length = std::uniform_int_distribution<size_t>(
+                    0, std::min<size_t>(old_source.size() - offset, 24))(rng);
+                std::string inserted;
+                switch (std::uniform_int_distribution<int>(0, 2)(rng)) {
+                case 0:
+                    inserted = randomFragment(rng, true);
+                    break;
+                case 1:
+                    inserted = std::string(1, kEditChars[std::uniform_int_distribution<size_t>(
+                                                  0, sizeof(kEditChars) - 2)(rng)]);
+                    break;
+                default:
+                    break;
+                }
+                auto new_source = std::make_unique<std::string>(old_source.substr(0, offset) + inserted +
+                                                                 old_source.substr(offset + old_length));
+                setContext("seed=" + std::to_string(seed) + " step=" + std::to_string(step) +
+                           " offset=" + std::to_string(offset) + " old_length=" + std::to_string(old_length) +
+                           " inserted=\"" + inserted + "\"");
+
+                std::optional<TokenBuffer> expected;
+                try {
+                    Lexical full(std::string_view(*new_source), engine);
+                    full.setSymbolTable(&symbols);
+                    expected.emplace(full.tokenize());
+                } catch (const LexicalException&) {
+                }
+
+                SourceEdit edit{offset, old_length, inserted.size()};
+                if (!expected) {
+                    bool threw = false;
+                    try {
+                        relexEdit(tokens, *new_source, edit, engine, &symbols);
+                    } catch (const LexicalException&) {
+                        threw = true;
+                    }
+                    DL_CHECK(threw);
+                    Lexical unchanged(std::string_view(old_source), engine);
+                    unchanged.setSymbolTable(&symbols);
+                    DL_CHECK_SAME_TOKENS(tokens, unchanged.tokenize());
+                    continue;
+                }
+
+                TokenChange change = relexEdit(tokens, *new_source, edit, engine, &symbols);
+                DL_CHECK_SAME_TOKENS(tokens, *expected);
+                DL_CHECK(change.first <= change.new_end && change.new_end <= tokens.size());
+                versions.push_back(std::move(new_source));
+            }
+        }
+    }
+}
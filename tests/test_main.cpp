@@ -0,0 +1,27 @@
+#include "test_support.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * 测试入口：不带参数时运行全部用例，否则只运行指定名字的用例（ctest 按名字逐个调用）
+ */
+int main(int argc, char* argv[]) {
+    using dreamlang::test::registry;
+
+    size_t run = 0;
+    for (const auto& test : registry()) {
+        if (argc > 1 && std::strcmp(argv[1], test.name) != 0) {
+            continue;
+        }
+        std::printf("[ RUN  ] %s\n", test.name);
+        test.run();
+        std::printf("[  OK  ] %s\n", test.name);
+        ++run;
+    }
+
+    if (run == 0) {
+        std::fprintf(stderr, "No test named '%s'\n", argc > 1 ? argv[1] : "");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "test_support.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace dreamlang::test {
+
+namespace {
+
+std::string& context() {
+    static thread_local std::string value;
+    return value;
+}
+
+// 片段之间合法的分隔符
+const char* const kSeparators[] = {" ", "  ", "\t", "\n", " \n", "\r\n", "\n\n"};
+
+// 总能单独通过词法分析的片段
+const char* const kFragments[] = {
+    "x", "value", "_tmp", "camelCase", "a1", "变量", "名字_2",
+    "var", "val", "fun", "return", "if", "else", "while", "class", "import", "package",
+    "true", "false", "null",
+    "0", "7", "42", "3.14", "1e10", "2.5e-3", "0x1F", "0b1011", "1_000_000", "0xFF_FF",
+    "123456789012345678901234567890", "99999999999999999999.5",
+    "\"\"", "\"hello\"", "\"a\\nb\"", "\"tab\\there\"", "\"quote \\\" inside\"", "\"\\\\\"", "\"中文\"",
+    "'a'", "'\\n'", "'\\''",
+    "// line comment", "//", "/* block */", "/**/", "/* multi\nline\ncomment */",
+    "=", "+", "-", "*", "/", "%", "**", "==", "!=", ">", "<", ">=", "<=", "&&", "||", "!",
+    ".", ",", ":", ";", "(", ")", "[", "]", "{", "}",
+};
+
+// 会引发词法错误的片段
+const char* const kErrorFragments[] = {"@", "`", "#", "\"unterminated", "/* unterminated", "$"};
+
+template <typename T, size_t N>
+const T& pick(std::mt19937& rng, const T (&values)[N]) {
+    return values[std::uniform_int_distribution<size_t>(0, N - 1)(rng)];
+}
+
+} // namespace
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void setContext(std::string value) {
+    context() = std::move(value);
+}
+
+void fail(const char* file, int line, const std::string& message) {
+    std::fprintf(stderr, "%s:%d: %s\n", file, line, message.c_str());
+    if (!context().empty()) {
+        std::fprintf(stderr, "context: %s\n", context().c_str());
+    }
+    std::exit(1);
+}
+
+std::string randomFragment(std::mt19937& rng, bool allow_errors) {
+    std::uniform_int_distribution<int> roll(0, 99);
+    int kind = roll(rng);
+    if (allow_errors && kind < 5) {
+        return pick(rng, kErrorFragments);
+    }
+    // 偶尔生成很长的字符串或注释，使其跨越分块、窗口和编辑边界
+    if (kind < 10) {
+        std::string body(std::uniform_int_distribution<size_t>(16, 400)(rng), 'z');
+        for (size_t i = 0; i < body.size(); i += 7) {
+            body[i] = ' ';
+        }
+        if (kind < 7) {
+            return "\"" + body + "\"";
+        }
+        for (size_t i = 3; i < body.size(); i += 29) {
+            body[i] = '\n';
+        }
+        return "/*" + body + "*/";
+    }
+    return pick(rng, kFragments);
+}
+
+std::string randomSource(std::mt19937& rng, size_t fragments, bool allow_errors) {
+    std::string source;
+    for (size_t i = 0; i < fragments; ++i) {
+        std::string fragment = randomFragment(rng, allow_errors);
+        source += fragment;
+        // 单行注释必须以换行结束，否则会吞掉后面的片段
+        source += fragment.rfind("//", 0) == 0 ? "\n" : pick(rng, kSeparators);
+    }
+    return source;
+}
+
+void checkSameTokens(const lexer::TokenBuffer& actual, const lexer::TokenBuffer& expected, const char* file,
+                     int line) {
+    if (actual.size() != expected.size()) {
+        fail(file, line,
+             "token count " + std::to_string(actual.size()) + " != expected " + std::to_string(expected.size()));
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        lexer::Token a = actual[i];
+        lexer::Token e = expected[i];
+        if (a.getType() != e.getType() || a.getOffset() != e.getOffset() || a.getLength() != e.getLength() ||
+            a.getValue() != e.getValue() || a.getPayload() != e.getPayload() || a.getFlags() != e.getFlags()) {
+            fail(file, line, "token " + std::to_string(i) + " differs: " + a.toString(actual.lineIndex()) +
+                                 " != expected " + e.toString(expected.lineIndex()));
+        }
+    }
+}
+
+} // namespace dreamlang::test
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "lexer/lexical.h"
+#include "lexer/token_buffer.h"
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace dreamlang::test {
+
+/**
+ * 一个测试用例：名字即 ctest 中的测试名
+ */
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+/**
+ * 所有已注册的测试用例
+ */
+std::vector<TestCase>& registry();
+
+/**
+ * 在静态初始化时注册测试用例
+ */
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { registry().push_back({name, run}); }
+};
+
+/**
+ * 设置失败时一并输出的上下文（如随机种子和当前输入），便于复现
+ */
+void setContext(std::string context);
+
+/**
+ * 输出失败信息和上下文并以非零状态退出
+ */
+[[noreturn]] void fail(const char* file, int line, const std::string& message);
+
+/**
+ * 生成一个随机源码片段
+ * @param rng 随机数发生器
+ * @param allow_errors 是否可能生成词法错误（非法字符、未闭合的字符串或注释）
+ */
+std::string randomFragment(std::mt19937& rng, bool allow_errors = false);
+
+/**
+ * 生成由 fragments 个片段组成的随机源码，片段之间以空白或换行分隔
+ *
+ * 不允许错误时生成的源码总能通过词法分析；字符串和注释可能很长，足以跨越并行分析的分块边界。
+ */
+std::string randomSource(std::mt19937& rng, size_t fragments, bool allow_errors = false);
+
+/**
+ * 检查两个Token序列完全相同（类型、边界、值、附加值与标志位）
+ */
+void checkSameTokens(const lexer::TokenBuffer& actual, const lexer::TokenBuffer& expected, const char* file,
+                     int line);
+
+} // namespace dreamlang::test
+
+#define DL_TEST(name)                                                              \
+    static void name();                                                            \
+    static ::dreamlang::test::Registrar name##_registrar(#name, name);             \
+    static void name()
+
+#define DL_CHECK(condition)                                                        \
+    do {                                                                           \
+        if (!(condition)) {                                                        \
+            ::dreamlang::test::fail(__FILE__, __LINE__, "check failed: " #condition); \
+        }                                                                          \
+    } while (0)
+
+#define DL_CHECK_SAME_TOKENS(actual, expected) ::dreamlang::test::checkSameTokens(actual, expected, __FILE__, __LINE__)
@@ -0,0 +1,60 @@
+#include "test_support.h"
+#include "lexer/token_cursor.h"
+#include <algorithm>
+#include <utility>
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+namespace {
+
+// 检查游标产出的Token与顺序分析结果中的第 index 个相同
+void checkToken(const Token& token, const TokenBuffer& expected, size_t index) {
+    DL_CHECK(token.getType() == expected.type(index));
+    DL_CHECK(token.getOffset() == expected.offset(index));
+    DL_CHECK(token.getLength() == expected.length(index));
+    DL_CHECK(token.getValue() == expected.value(index));
+}
+
+} // namespace
+
+/**
+ * 随机前进、前瞻、记录和回退（包括回退到早已移出环形缓冲区的位置）时，
+ * 游标看到的Token序列始终与顺序分析相同
+ */
+DL_TEST(token_cursor) {
+    for (unsigned seed = 0; seed < 200; ++seed) {
+        std::mt19937 rng(seed);
+        std::string source = randomSource(rng, std::uniform_int_distribution<size_t>(0, 60)(rng));
+        Lexical sequential(std::string_view(source), LexerEngine::CLASSIC);
+        TokenBuffer expected = sequential.tokenize();
+        size_t last = expected.size() - 1;
+
+        size_t capacity = size_t{1} << std::uniform_int_distribution<int>(0, 3)(rng);
+        Lexical lexer(std::string_view(source), LexerEngine::CLASSIC);
+        TokenCursor cursor(lexer, capacity);
+        setContext("seed=" + std::to_string(seed) + " capacity=" + std::to_string(cursor.capacity()));
+
+        // 期望位置：已消费的Token数，到达EOF后不再增加
+        size_t model = 0;
+        std::vector<std::pair<TokenCursor::Mark, size_t>> marks;
+        for (unsigned step = 0; step < 300; ++step) {
+            int operation = std::uniform_int_distribution<int>(0, 9)(rng);
+            if (operation < 5) {
+                Token token = cursor.advance();
+                checkToken(token, expected, model);
+                model = std::min(model + 1, last);
+            } else if (operation == 5) {
+                size_t n = std::uniform_int_distribution<size_t>(0, cursor.capacity() - 1)(rng);
+                checkToken(cursor.peek(n), expected, std::min(model + n, last));
+            } else if (operation < 8) {
+                marks.emplace_back(cursor.mark(), model);
+            } else if (!marks.empty()) {
+                const auto& checkpoint = marks[std::uniform_int_distribution<size_t>(0, marks.size() - 1)(rng)];
+                cursor.rewind(checkpoint.first);
+                model = checkpoint.second;
+            }
+            checkToken(cursor.peek(), expected, model);
+        }
+    }
+}
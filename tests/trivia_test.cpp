@@ -0,0 +1,70 @@
+#include "test_support.h"
+#include "lexer/trivia_table.h"
+#include <algorithm>
+
+using namespace dreamlang::lexer;
+using namespace dreamlang::test;
+
+/**
+ * TriviaLexical 产生的Token与 Lexical 相同，且琐碎内容与Token恰好不重不漏地覆盖源码的每个字节
+ */
+DL_TEST(trivia_coverage) {
+    for (unsigned seed = 0; seed < 300; ++seed) {
+        std::mt19937 rng(seed);
+        std::string source = randomSource(rng, std::uniform_int_distribution<size_t>(0, 60)(rng));
+        setContext("seed=" + std::to_string(seed));
+
+        TriviaLexical lexer{std::string_view(source)};
+        TokenBuffer tokens = lexer.tokenize();
+        Lexical plain{std::string_view(source)};
+        DL_CHECK_SAME_TOKENS(tokens, plain.tokenize());
+
+        struct Span {
+            size_t offset;
+            size_t length;
+        };
+        std::vector<Span> spans;
+        for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+            DL_CHECK(tokens.length(i) > 0);
+            spans.push_back({tokens.offset(i), tokens.length(i)});
+        }
+
+        const TriviaTable& trivia = lexer.getTrivia();
+        for (size_t i = 0; i < trivia.size(); ++i) {
+            std::string_view text = trivia.text(i);
+            DL_CHECK(!text.empty());
+            switch (trivia.kind(i)) {
+            case TriviaKind::WHITESPACE:
+                DL_CHECK(text.find_first_not_of(" \t\r") == std::string_view::npos);
+                break;
+            case TriviaKind::NEWLINE:
+                // 策略产生 LINEBREAK Token，换行符不应再记为琐碎内容
+                DL_CHECK(false);
+                break;
+            case TriviaKind::LINE_COMMENT:
+                DL_CHECK(text.substr(0, 2) == "//" && text.find('\n') == std::string_view::npos);
+                break;
+            case TriviaKind::BLOCK_COMMENT:
+                DL_CHECK(text.size() >= 4 && text.substr(0, 2) == "/*" && text.substr(text.size() - 2) == "*/");
+                break;
+            }
+
+            // 链接的Token紧跟在这段内容之后
+            size_t token_index = trivia.tokenIndex(i);
+            DL_CHECK(token_index < tokens.size());
+            DL_CHECK(tokens.offset(token_index) >= trivia.offset(i) + trivia.length(i));
+            if (token_index > 0) {
+                DL_CHECK(tokens.offset(token_index - 1) + tokens.length(token_index - 1) <= trivia.offset(i));
+            }
+            spans.push_back({trivia.offset(i), trivia.length(i)});
+        }
+
+        std::sort(spans.begin(), spans.end(), [](const Span& a, const Span& b) { return a.offset < b.offset; });
+        size_t covered = 0;
+        for (const Span& span : spans) {
+            DL_CHECK(span.offset == covered);
+            covered += span.length;
+        }
+        DL_CHECK(covered == source.size());
+    }
+}